@@ -216,6 +216,29 @@ typedef struct
     NvU32 *data;
 } nv_parm_t;
 
+#define NV_RMAPI_CONTROL_CACHE_STATS_CMDS 16
+
+typedef struct
+{
+    NvU32 cmd;
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 evictions;
+} nv_rmapi_control_cache_cmd_stats_t;
+
+typedef struct
+{
+    NvU64 control_cache_hits;
+    NvU64 control_cache_misses;
+    NvU64 control_cache_evictions;
+    NvU32 control_cache_num_cmds;
+    nv_rmapi_control_cache_cmd_stats_t control_cache_cmds[NV_RMAPI_CONTROL_CACHE_STATS_CMDS];
+    nv_rmapi_control_cache_cmd_stats_t control_cache_other;  // controls without their own entry
+    NvU64 param_copy_cache_hits;
+    NvU64 param_copy_cache_misses;
+    NvU64 param_copy_cache_uncached;
+} nv_rmapi_cache_stats_t;
+
 #define NV_RM_PAGE_SHIFT    12
 #define NV_RM_PAGE_SIZE     (1 << NV_RM_PAGE_SHIFT)
 #define NV_RM_PAGE_MASK     (NV_RM_PAGE_SIZE - 1)
@@ -919,6 +942,7 @@ char*      NV_API_CALL  rm_get_gpu_uuid          (nvidia_stack_t *, nv_state_t *
 const NvU8* NV_API_CALL rm_get_gpu_uuid_raw      (nvidia_stack_t *, nv_state_t *);
 void       NV_API_CALL  rm_set_rm_firmware_requested(nvidia_stack_t *, nv_state_t *);
 void       NV_API_CALL  rm_get_firmware_version  (nvidia_stack_t *, nv_state_t *, char *, NvLength);
+void       NV_API_CALL  rm_get_rmapi_cache_stats (nvidia_stack_t *, nv_rmapi_cache_stats_t *);
 void       NV_API_CALL  rm_cleanup_file_private  (nvidia_stack_t *, nv_state_t *, nv_file_private_t *);
 void       NV_API_CALL  rm_unbind_lock           (nvidia_stack_t *, nv_state_t *);
 NV_STATUS  NV_API_CALL  rm_read_registry_dword   (nvidia_stack_t *, nv_state_t *, const char *, NvU32 *);
@@ -213,9 +213,42 @@ static inline unsigned long NVKMS_USECS_TO_JIFFIES(NvU64 usec)
 /*************************************************************************
  * NVKMS uses a global lock, nvkms_lock.  The lock is taken in the
  * file operation callback functions when calling into core NVKMS.
+ *
+ * Ioctls that core NVKMS reports as device-local (see
+ * nvKmsIoctlIsDeviceLocal()), and device timers when core NVKMS allows it
+ * (see nvkms_alloc_device_timer() and nvKmsTimerIsDeviceLocal()), only
+ * hold nvkms_lock long enough to take nvkms_device_ops_lock for reading;
+ * they are then serialized against each other with a per-device lock.
+ * Everything else holds nvkms_lock and nvkms_device_ops_lock for writing,
+ * which excludes all in-flight device-local work.  The lock order is
+ * nvkms_lock, then nvkms_device_ops_lock, then the per-device lock.
  *************************************************************************/
 
 static struct semaphore nvkms_lock;
+static struct rw_semaphore nvkms_device_ops_lock;
+
+static inline void nvkms_lock_global(void)
+{
+    down(&nvkms_lock);
+    down_write(&nvkms_device_ops_lock);
+}
+
+static inline int nvkms_lock_global_interruptible(void)
+{
+    int status = down_interruptible(&nvkms_lock);
+
+    if (status == 0) {
+        down_write(&nvkms_device_ops_lock);
+    }
+
+    return status;
+}
+
+static inline void nvkms_unlock_global(void)
+{
+    up_write(&nvkms_device_ops_lock);
+    up(&nvkms_lock);
+}
 
 /*************************************************************************
  * User clients of NVKMS may need to be synchronized with suspend/resume
@@ -297,7 +330,8 @@ static inline void nvkms_write_unlock_pm_lock(void)
 
 /*************************************************************************
  * nvidia-modeset-os-interface.h functions.  It is assumed that these
- * are called while nvkms_lock is held.
+ * are called while nvkms_lock is held, or from a device-local ioctl,
+ * which holds nvkms_device_ops_lock for reading.
  *************************************************************************/
 
 /* Don't use kmalloc for allocations larger than one page */
@@ -527,16 +561,16 @@ static void nvkms_suspend(NvU32 gpuId)
         nvkms_write_lock_pm_lock();
     }
 
-    down(&nvkms_lock);
+    nvkms_lock_global();
     nvKmsSuspend(gpuId);
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 }
 
 static void nvkms_resume(NvU32 gpuId)
 {
-    down(&nvkms_lock);
+    nvkms_lock_global();
     nvKmsResume(gpuId);
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 
     if (gpuId == 0) {
         nvkms_write_unlock_pm_lock();
@@ -668,6 +702,8 @@ struct nvkms_timer_t {
     nvkms_timer_proc_t *proc;
     void *dataPtr;
     NvU32 dataU32;
+    nvkms_sema_handle_t *device_lock;
+    nvkms_timer_device_lock_proc_t *get_device_lock;
     struct list_head timers_list;
 };
 
@@ -682,6 +718,8 @@ static struct {
 static void nvkms_kthread_q_callback(void *arg)
 {
     struct nvkms_timer_t *timer = arg;
+    nvkms_sema_handle_t *device_lock = NULL;
+    NvBool device_local = NV_FALSE;
     void *dataPtr;
     unsigned long flags = 0;
 
@@ -722,6 +760,34 @@ static void nvkms_kthread_q_callback(void *arg)
         dataPtr = timer->dataPtr;
     }
 
+    /*
+     * Device timers are canceled, or the object they refer to is destroyed,
+     * under nvkms_lock before their device lock is freed, so only look up the
+     * device lock if the timer is still live.
+     */
+    if (!timer->cancel) {
+        if (timer->get_device_lock != NULL) {
+            device_lock = timer->get_device_lock(dataPtr);
+        } else {
+            device_lock = timer->device_lock;
+        }
+
+        if (device_lock != NULL) {
+            device_local = nvKmsTimerIsDeviceLocal();
+        }
+    }
+
+    if (device_local) {
+        down_read(&nvkms_device_ops_lock);
+        up(&nvkms_lock);
+    } else {
+        down_write(&nvkms_device_ops_lock);
+    }
+
+    if (device_lock != NULL) {
+        nvkms_sema_down(device_lock);
+    }
+
     if (!timer->cancel) {
         timer->proc(dataPtr, timer->dataU32);
         timer->complete = NV_TRUE;
@@ -734,7 +800,15 @@ static void nvkms_kthread_q_callback(void *arg)
         nvkms_free(timer, sizeof(*timer));
     }
 
-    up(&nvkms_lock);
+    if (device_lock != NULL) {
+        nvkms_sema_up(device_lock);
+    }
+
+    if (device_local) {
+        up_read(&nvkms_device_ops_lock);
+    } else {
+        nvkms_unlock_global();
+    }
 
     nvkms_read_unlock_pm_lock();
 }
@@ -778,7 +852,9 @@ inline static void nvkms_timer_callback_anon_data(unsigned long arg)
 
 static void
 nvkms_init_timer(struct nvkms_timer_t *timer, nvkms_timer_proc_t *proc,
-                 void *dataPtr, NvU32 dataU32, NvBool isRefPtr, NvU64 usec)
+                 void *dataPtr, NvU32 dataU32, NvBool isRefPtr, NvU64 usec,
+                 nvkms_sema_handle_t *device_lock,
+                 nvkms_timer_device_lock_proc_t *get_device_lock)
 {
     unsigned long flags = 0;
 
@@ -790,6 +866,8 @@ nvkms_init_timer(struct nvkms_timer_t *timer, nvkms_timer_proc_t *proc,
     timer->proc = proc;
     timer->dataPtr = dataPtr;
     timer->dataU32 = dataU32;
+    timer->device_lock = device_lock;
+    timer->get_device_lock = get_device_lock;
 
     nv_kthread_q_item_init(&timer->nv_kthread_q_item, nvkms_kthread_q_callback,
                            timer);
@@ -830,15 +908,32 @@ nvkms_alloc_timer(nvkms_timer_proc_t *proc,
     // nvkms_alloc_timer cannot be called from an interrupt context.
     struct nvkms_timer_t *timer = nvkms_alloc(sizeof(*timer), NV_FALSE);
     if (timer) {
-        nvkms_init_timer(timer, proc, dataPtr, dataU32, NV_FALSE, usec);
+        nvkms_init_timer(timer, proc, dataPtr, dataU32, NV_FALSE, usec,
+                         NULL, NULL);
     }
     return timer;
 }
 
-NvBool
-nvkms_alloc_timer_with_ref_ptr(nvkms_timer_proc_t *proc,
-                               struct nvkms_ref_ptr *ref_ptr,
-                               NvU32 dataU32, NvU64 usec)
+nvkms_timer_handle_t*
+nvkms_alloc_device_timer(nvkms_timer_proc_t *proc,
+                         void *dataPtr, NvU32 dataU32,
+                         NvU64 usec,
+                         nvkms_sema_handle_t *device_lock)
+{
+    struct nvkms_timer_t *timer = nvkms_alloc(sizeof(*timer), NV_FALSE);
+    if (timer) {
+        nvkms_init_timer(timer, proc, dataPtr, dataU32, NV_FALSE, usec,
+                         device_lock, NULL);
+    }
+    return timer;
+}
+
+static NvBool
+nvkms_alloc_timer_with_ref_ptr_internal(
+    nvkms_timer_proc_t *proc,
+    struct nvkms_ref_ptr *ref_ptr,
+    NvU32 dataU32, NvU64 usec,
+    nvkms_timer_device_lock_proc_t *get_device_lock)
 {
     // nvkms_alloc_timer_with_ref_ptr is called from an interrupt bottom half
     // handler, which runs in a tasklet (i.e. atomic) context.
@@ -847,12 +942,33 @@ nvkms_alloc_timer_with_ref_ptr(nvkms_timer_proc_t *proc,
         // Reference the ref_ptr to make sure that it doesn't get freed before
         // the timer fires.
         nvkms_inc_ref(ref_ptr);
-        nvkms_init_timer(timer, proc, ref_ptr, dataU32, NV_TRUE, usec);
+        nvkms_init_timer(timer, proc, ref_ptr, dataU32, NV_TRUE, usec,
+                         NULL, get_device_lock);
     }
 
     return timer != NULL;
 }
 
+NvBool
+nvkms_alloc_timer_with_ref_ptr(nvkms_timer_proc_t *proc,
+                               struct nvkms_ref_ptr *ref_ptr,
+                               NvU32 dataU32, NvU64 usec)
+{
+    return nvkms_alloc_timer_with_ref_ptr_internal(proc, ref_ptr, dataU32,
+                                                   usec, NULL);
+}
+
+NvBool
+nvkms_alloc_device_timer_with_ref_ptr(nvkms_timer_proc_t *proc,
+                                      struct nvkms_ref_ptr *ref_ptr,
+                                      NvU32 dataU32, NvU64 usec,
+                                      nvkms_timer_device_lock_proc_t
+                                          *get_device_lock)
+{
+    return nvkms_alloc_timer_with_ref_ptr_internal(proc, ref_ptr, dataU32,
+                                                   usec, get_device_lock);
+}
+
 void nvkms_free_timer(nvkms_timer_handle_t *handle)
 {
     struct nvkms_timer_t *timer = handle;
@@ -1013,7 +1129,7 @@ static int nvkms_update_backlight_status(struct backlight_device *bd)
     NvBool status;
     int ret;
 
-    ret = down_interruptible(&nvkms_lock);
+    ret = nvkms_lock_global_interruptible();
 
     if (ret != 0) {
         return ret;
@@ -1022,7 +1138,7 @@ static int nvkms_update_backlight_status(struct backlight_device *bd)
     status = nvKmsSetBacklight(nvkms_bd->display_id, nvkms_bd->drv_priv,
                                bd->props.brightness);
 
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 
     return status ? 0 : -EINVAL;
 }
@@ -1034,7 +1150,7 @@ static int nvkms_get_backlight_brightness(struct backlight_device *bd)
     NvBool status;
     int ret;
 
-    ret = down_interruptible(&nvkms_lock);
+    ret = nvkms_lock_global_interruptible();
 
     if (ret != 0) {
         return ret;
@@ -1043,7 +1159,7 @@ static int nvkms_get_backlight_brightness(struct backlight_device *bd)
     status = nvKmsGetBacklight(nvkms_bd->display_id, nvkms_bd->drv_priv,
                                &brightness);
 
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 
     return  status ? brightness : -1;
 }
@@ -1158,7 +1274,7 @@ struct nvkms_per_open *nvkms_open_common(enum NvKmsClientType type,
 
     popen->type = type;
 
-    *status = down_interruptible(&nvkms_lock);
+    *status = nvkms_lock_global_interruptible();
 
     if (*status != 0) {
         goto failed;
@@ -1166,7 +1282,7 @@ struct nvkms_per_open *nvkms_open_common(enum NvKmsClientType type,
 
     popen->data = nvKmsOpen(current->tgid, type, popen);
 
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 
     if (popen->data == NULL) {
         *status = -EPERM;
@@ -1203,13 +1319,13 @@ void nvkms_close_common(struct nvkms_per_open *popen)
      * mutex.
      */
 
-    down(&nvkms_lock);
+    nvkms_lock_global();
 
     nvKmsClose(popen->data);
 
     popen->data = NULL;
 
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 
     if (popen->type == NVKMS_CLIENT_KERNEL_SPACE) {
         /*
@@ -1266,19 +1382,39 @@ int nvkms_ioctl_common
 {
     int status;
     NvBool ret;
+    NvBool deviceLocal;
 
     status = down_interruptible(&nvkms_lock);
     if (status != 0) {
         return status;
     }
 
+    deviceLocal = (popen->data != NULL) &&
+                  nvKmsIoctlIsDeviceLocal(popen->data, cmd);
+
+    if (deviceLocal) {
+        /*
+         * Device-local ioctls only need to exclude global operations;
+         * core NVKMS serializes them per device.  Drop nvkms_lock so
+         * that ioctls targeting other devices can proceed.
+         */
+        down_read(&nvkms_device_ops_lock);
+        up(&nvkms_lock);
+    } else {
+        down_write(&nvkms_device_ops_lock);
+    }
+
     if (popen->data != NULL) {
         ret = nvKmsIoctl(popen->data, cmd, address, size);
     } else {
         ret = NV_FALSE;
     }
 
-    up(&nvkms_lock);
+    if (deviceLocal) {
+        up_read(&nvkms_device_ops_lock);
+    } else {
+        nvkms_unlock_global();
+    }
 
     return ret ? 0 : -EPERM;
 }
@@ -1393,7 +1529,7 @@ static int nv_procfs_read_nvkms_proc(struct seq_file *s, void *arg)
     buffer = nvkms_alloc(NVKMS_PROCFS_STRING_SIZE, NV_TRUE);
 
     if (buffer != NULL) {
-        int status = down_interruptible(&nvkms_lock);
+        int status = nvkms_lock_global_interruptible();
 
         if (status != 0) {
             nvkms_free(buffer, NVKMS_PROCFS_STRING_SIZE);
@@ -1402,7 +1538,7 @@ static int nv_procfs_read_nvkms_proc(struct seq_file *s, void *arg)
 
         func(s, buffer, NVKMS_PROCFS_STRING_SIZE, &nv_procfs_out_string);
 
-        up(&nvkms_lock);
+        nvkms_unlock_global();
 
         nvkms_free(buffer, NVKMS_PROCFS_STRING_SIZE);
     }
@@ -1633,6 +1769,7 @@ static int __init nvkms_init(void)
     }
 
     sema_init(&nvkms_lock, 1);
+    init_rwsem(&nvkms_device_ops_lock);
     init_rwsem(&nvkms_pm_lock);
 
     ret = nv_kthread_q_init(&nvkms_kthread_q,
@@ -1656,11 +1793,11 @@ static int __init nvkms_init(void)
         goto fail_register_module;
     }
 
-    down(&nvkms_lock);
+    nvkms_lock_global();
     if (!nvKmsModuleLoad()) {
         ret = -ENOMEM;
     }
-    up(&nvkms_lock);
+    nvkms_unlock_global();
     if (ret != 0) {
         goto fail_module_load;
     }
@@ -1688,9 +1825,9 @@ static void __exit nvkms_exit(void)
 
     nvkms_proc_exit();
 
-    down(&nvkms_lock);
+    nvkms_lock_global();
     nvKmsModuleUnload();
-    up(&nvkms_lock);
+    nvkms_unlock_global();
 
     /*
      * At this point, any pending tasks should be marked canceled, but
@@ -255,6 +255,59 @@ nv_procfs_read_version(
 
 NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(version);
 
+static int
+nv_procfs_read_rmapi_cache(
+    struct seq_file *s,
+    void *v
+)
+{
+    nvidia_stack_t *sp = NULL;
+    nv_rmapi_cache_stats_t *stats;
+    NvU32 i;
+
+    // Too large for the kernel stack with the per-control table.
+    NV_KMALLOC(stats, sizeof(*stats));
+    if (stats == NULL)
+    {
+        return 0;
+    }
+
+    if (nv_kmem_cache_alloc_stack(&sp) != 0)
+    {
+        NV_KFREE(stats, sizeof(*stats));
+        return 0;
+    }
+
+    rm_get_rmapi_cache_stats(sp, stats);
+
+    seq_printf(s, "Control cache hits:        %llu\n", stats->control_cache_hits);
+    seq_printf(s, "Control cache misses:      %llu\n", stats->control_cache_misses);
+    seq_printf(s, "Control cache evictions:   %llu\n", stats->control_cache_evictions);
+    seq_printf(s, "Param copy cache hits:     %llu\n", stats->param_copy_cache_hits);
+    seq_printf(s, "Param copy cache misses:   %llu\n", stats->param_copy_cache_misses);
+    seq_printf(s, "Param copy cache uncached: %llu\n", stats->param_copy_cache_uncached);
+
+    seq_printf(s, "\nControl cache by control:\n");
+    seq_printf(s, "%-10s %12s %12s %12s\n", "cmd", "hits", "misses", "evictions");
+    for (i = 0; i < stats->control_cache_num_cmds; i++)
+    {
+        nv_rmapi_control_cache_cmd_stats_t *cmd = &stats->control_cache_cmds[i];
+
+        seq_printf(s, "0x%08x %12llu %12llu %12llu\n",
+                   cmd->cmd, cmd->hits, cmd->misses, cmd->evictions);
+    }
+    seq_printf(s, "%-10s %12llu %12llu %12llu\n", "other",
+               stats->control_cache_other.hits,
+               stats->control_cache_other.misses,
+               stats->control_cache_other.evictions);
+
+    nv_kmem_cache_free_stack(sp);
+    NV_KFREE(stats, sizeof(*stats));
+    return 0;
+}
+
+NV_DEFINE_SINGLE_NVRM_PROCFS_FILE(rmapi_cache);
+
 static void
 nv_procfs_close_file(
     nv_procfs_private_t *nvpp
@@ -1377,6 +1430,10 @@ int nv_procfs_init(void)
     if (!entry)
         goto failed;
 
+    entry = NV_CREATE_PROC_FILE("rmapi_cache", proc_nvidia, rmapi_cache, NULL);
+    if (!entry)
+        goto failed;
+
     proc_nvidia_gpus = NV_CREATE_PROC_DIR("gpus", proc_nvidia);
     if (!proc_nvidia_gpus)
         goto failed;
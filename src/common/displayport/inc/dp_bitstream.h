@@ -53,9 +53,21 @@ namespace DisplayPort
         // Read 1-32 bits from stream.  Returns 'default' on failure.
         unsigned  readOrDefault(unsigned bits, unsigned defaultValue);
 
+        //
+        //  Read 'count' whole bytes into data.  Bytes beyond the end of the
+        //  stream are zero filled and false is returned.
+        //
+        bool readBytes(NvU8 * data, unsigned count);
+
         // Skip bits until we're aligned to the power of two alignment
         bool align(unsigned align);
 
+        // Advance the stream by 'bits' without reading.  Returns true on success
+        bool skip(unsigned bits);
+
+        // Number of bits left before the end of the stream
+        unsigned  remaining();
+
         unsigned  offset();
         Buffer *  buffer();
         BitStreamReader(Buffer * buffer, unsigned bitsOffset, unsigned bitsCount);
@@ -81,6 +93,12 @@ namespace DisplayPort
         //
         bool write(unsigned value, unsigned bits);
 
+        //
+        //  Write 'count' whole bytes.  Copied in bulk when the stream is
+        //  byte aligned.
+        //
+        bool writeBytes(const NvU8 * data, unsigned count);
+
         //
         // Emit zero's until the offset is divisible by align.
         //  CAVEAT: align must be a power of 2 (eg 8)
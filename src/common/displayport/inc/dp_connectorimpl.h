@@ -176,6 +176,31 @@ namespace DisplayPort
         unsigned compoundQueryCount;
         unsigned compoundQueryLocalLinkPBN;
 
+        //
+        // Memoized watermark (isModePossible*) results.  These depend on the
+        // link configuration, the mode and the GPU's FEC/watermark
+        // capabilities; the capabilities are part of each entry, and the
+        // cache is also cleared on GPU capability, link and topology changes.
+        // See isModePossibleCached().
+        //
+        enum { modePossibleCacheSize = 32 };    // power of 2
+        struct ModePossibleCacheEntry
+        {
+            bool              valid;
+            bool              bMultistream;
+            bool              bFECSupported;
+            bool              bIncreasedWatermarkLimits;
+            bool              bPossible;
+            LinkConfiguration linkConfig;
+            ModesetInfo       modesetInfo;
+        };
+        ModePossibleCacheEntry modePossibleCache[modePossibleCacheSize];
+        unsigned modePossibleCacheHits;
+        unsigned modePossibleCacheMisses;
+
+        // Scratch memory for DSC PPS generation during mode validation
+        DSC_GENERATE_PPS_WORKSPACE dscPpsWorkspace;
+
         unsigned freeSlots, maximumSlots;
 
         // Multistream messaging
@@ -470,6 +495,8 @@ namespace DisplayPort
         void setIgnoreSourceOuiHandshake(bool bIgnore);
         bool getIgnoreSourceOuiHandshake();
         bool willLinkSupportModeSST(const LinkConfiguration & linkConfig, const ModesetInfo & modesetInfo);
+        bool isModePossibleCached(const LinkConfiguration & linkConfig, const ModesetInfo & modesetInfo, bool bMultistream);
+        void invalidateModePossibleCache();
         void forceLinkTraining();
 
         void assessLink(LinkTrainingType trainType = NORMAL_LINK_TRAINING);
@@ -184,12 +184,25 @@ namespace DisplayPort
         };
 
         enum {
-            maximumTopologyNodes =  128
+            maximumTopologyNodes =  128,
+            deviceIndexSize      =  2 * maximumTopologyNodes    // power of 2
         };
 
         Device  currentDevices[maximumTopologyNodes];
         unsigned currentDevicesCount;
 
+        //
+        //  Open-addressed hash indices into currentDevices by address and by
+        //  GUID.  Slots hold (index + 1); 0 marks an empty slot.  Rebuilt
+        //  whenever devices are removed, since removal compacts the array.
+        //
+        NvU8    addressIndex[deviceIndexSize];
+        NvU8    guidIndex[deviceIndexSize];
+
+        void indexDevice(unsigned deviceIndex);
+        void rebuildDeviceIndices();
+        void notifyLostDevice(const Device & device);
+
         Device * findDevice(const Address & address);
         Device * findDevice(GUID & guid);
         void addDevice(const Device & device);
@@ -307,6 +320,8 @@ public:
             //   connection status notify events are on their way.
             //
             messageManager->registerReceiver(&connectionStatusNotifyProcessor);
+
+            rebuildDeviceIndices();
         }
 
        ~DiscoveryManager()
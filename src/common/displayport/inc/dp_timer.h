@@ -64,25 +64,57 @@ namespace DisplayPort
         };
 
     private:
-        RawTimer * raw;
-        NvU64      nextTimestamp;
-        List       pending;
-        struct PendingCallback : ListElement
+        struct PendingCallback
         {
             TimerCallback *    target;
             const void *       context;
             NvU64              timestamp; // in usec
+            NvU64              sequence;  // orders callbacks with equal timestamps
             bool               executeInSleep;
+            PendingCallback *  nextFree;
+        };
+
+        //
+        //  Binary min-heap of pending callbacks ordered by (timestamp, sequence).
+        //
+        struct CallbackHeap
+        {
+            PendingCallback ** items;
+            unsigned           count;
+            unsigned           capacity;
 
+            CallbackHeap() : items(0), count(0), capacity(0) {}
+            bool push(PendingCallback * callback);
+            PendingCallback * pop();
+            PendingCallback * top() const { return count ? items[0] : 0; }
+            void siftUp(unsigned index);
+            void siftDown(unsigned index);
         };
 
+        RawTimer * raw;
+        NvU64      nextTimestamp;
+        NvU64      nextSequence;
+
+        //
+        //  Callbacks that may run from within sleep(), and those that may not,
+        //  are kept apart so that sleep() only has to look at the former.
+        //
+        CallbackHeap sleepPending;
+        CallbackHeap wakePending;
+
+        // Recycled PendingCallback nodes
+        PendingCallback * freeCallbacks;
+
         virtual void expired();
         unsigned fire(bool fromSleep);
 
         void _pump(unsigned milliseconds, bool fromSleep);
+        PendingCallback * nextPending(bool fromSleep, CallbackHeap ** heap);
+        PendingCallback * allocCallback();
+        void freeCallback(PendingCallback * callback);
     public:
-        Timer(RawTimer * raw) : raw(raw) {}
-        virtual ~Timer() {}
+        Timer(RawTimer * raw) : raw(raw), nextTimestamp(0), nextSequence(0), freeCallbacks(0) {}
+        virtual ~Timer();
 
         //
         //  Queue a timer callback.
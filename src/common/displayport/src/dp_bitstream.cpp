@@ -56,21 +56,55 @@ bool BitStreamReader::read(unsigned * value, unsigned bits)
     }
 
     //
-    //  We're either reading too many bits or we're straddling
-    //  a byte boundary.  Serialize bit by bit.
-    //  NOTE: This scenario is entire unlikely.  Don't optimize.
+    //  We're straddling a byte boundary.  Gather every byte the field
+    //  touches (at most 5 for a 32 bit field) into a 64-bit accumulator
+    //  and extract the field with a single shift and mask.
     //
+    unsigned firstByte = this->bitsOffset / 8;
+    unsigned lastByte  = (this->bitsOffset + bits - 1) / 8;
+    const NvU8 * data  = this->buffer()->data;
+    NvU64 accumulator  = 0;
 
-    *value = 0;
-    while (bits) 
+    for (unsigned i = firstByte; i <= lastByte; i++)
     {
-        unsigned bit;
-        if (!read(&bit, 1))
+        accumulator = (accumulator << 8) | data[i];
+    }
+
+    unsigned bottombit = (lastByte + 1) * 8 - (this->bitsOffset + bits);
+    *value = (unsigned)((accumulator >> bottombit) & ((1ULL << bits) - 1));
+
+    this->bitsOffset += bits;
+    return true;
+}
+
+bool BitStreamReader::readBytes(NvU8 * data, unsigned count)
+{
+    unsigned available = this->remaining() / 8;
+    unsigned n = count < available ? count : available;
+
+    if (n)
+    {
+        if ((this->bitsOffset & 7) == 0)
         {
-            return false;
+            dpMemCopy(data, this->buffer()->data + this->bitsOffset / 8, n);
+            this->bitsOffset += n * 8;
         }
-        *value = *value * 2 + bit;
-        bits--;
+        else
+        {
+            for (unsigned i = 0; i < n; i++)
+            {
+                unsigned byte;
+                read(&byte, 8);
+                data[i] = (NvU8)byte;
+            }
+        }
+    }
+
+    // Match readOrDefault(8, 0) for anything past the end of the stream
+    if (n < count)
+    {
+        dpMemZero(data + n, count - n);
+        return false;
     }
 
     return true;
@@ -108,6 +142,27 @@ bool BitStreamReader::align(unsigned align)
     return this->bitsOffset <= this->bitsEnd;
 }
 
+bool BitStreamReader::skip(unsigned bits)
+{
+    if (this->bitsOffset + bits > this->bitsEnd)
+    {
+        return false;
+    }
+
+    this->bitsOffset += bits;
+    return true;
+}
+
+unsigned BitStreamReader::remaining()
+{
+    if (this->bitsOffset >= this->bitsEnd)
+    {
+        return 0;
+    }
+
+    return this->bitsEnd - this->bitsOffset;
+}
+
 bool BitStreamWriter::write(unsigned value, unsigned bits)
 {
     DP_ASSERT((value < (1ULL << bits)) && "Value out of range");
@@ -135,15 +190,59 @@ bool BitStreamWriter::write(unsigned value, unsigned bits)
     }
 
     //
-    //  We're either writing too many bits or we're straddling
-    //  a byte boundary.  Serialize bit by bit.
-    //  NOTE: This scenario is entire unlikely.  Don't optimize.
+    //  We're straddling a byte boundary.  Merge the field into a 64-bit
+    //  accumulator holding every byte it touches and store them back,
+    //  preserving the bits on either side of the field.
     //
+    unsigned firstByte = this->bitsOffset / 8;
+    unsigned lastByte  = (this->bitsOffset + bits - 1) / 8;
+    NvU8 * data        = this->buffer()->data;
+    NvU64 accumulator  = 0;
+
+    for (unsigned i = firstByte; i <= lastByte; i++)
+    {
+        accumulator = (accumulator << 8) | data[i];
+    }
+
+    unsigned bottombit = (lastByte + 1) * 8 - (this->bitsOffset + bits);
+    NvU64 clearmask = ((1ULL << bits) - 1) << bottombit;
+    accumulator = (accumulator &~ clearmask) | (((NvU64)value << bottombit) & clearmask);
+
+    for (unsigned i = lastByte + 1; i > firstByte; i--)
+    {
+        data[i - 1] = (NvU8)accumulator;
+        accumulator >>= 8;
+    }
+
+    this->bitsOffset += bits;
+    return true;
+}
+
+bool BitStreamWriter::writeBytes(const NvU8 * data, unsigned count)
+{
+    if (!count)
+    {
+        return true;
+    }
+
+    if (this->bitsOffset + count * 8 > this->buffer()->length * 8)
+    {
+        if (!this->buffer()->resize((this->bitsOffset + count * 8 + 7) / 8))
+        {
+            return false;
+        }
+    }
+
+    if ((this->bitsOffset & 7) == 0)
+    {
+        dpMemCopy(this->buffer()->data + this->bitsOffset / 8, data, count);
+        this->bitsOffset += count * 8;
+        return true;
+    }
 
-    while (bits)
+    for (unsigned i = 0; i < count; i++)
     {
-        bits --;
-        if (!write( (value >> bits) & 1, 1))
+        if (!write(data[i], 8))
         {
             return false;
         }
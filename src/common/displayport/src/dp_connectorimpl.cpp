@@ -100,6 +100,8 @@ ConnectorImpl::ConnectorImpl(MainLink * main, AuxBus * auxBus, Timer * timer, Co
       compoundQueryActive(false),
       compoundQueryResult(false),
       compoundQueryCount(0),
+      modePossibleCacheHits(0),
+      modePossibleCacheMisses(0),
       messageManager(0),
       discoveryManager(0),
       numPossibleLnkCfg(0),
@@ -119,6 +121,8 @@ ConnectorImpl::ConnectorImpl(MainLink * main, AuxBus * auxBus, Timer * timer, Co
       bDscCapBasedOnParent(false),
       ResStatus(this)
 {
+    invalidateModePossibleCache();
+
     clearTimeslices();
     hal = MakeDPCDHAL(auxBus, timer);
     if (hal == NULL)
@@ -308,6 +312,8 @@ void ConnectorImpl::messageProcessed(MessageManager::MessageReceiver * from)
 
 void ConnectorImpl::discoveryNewDevice(const DiscoveryManager::Device & device)
 {
+    invalidateModePossibleCache();
+
     //
     //  We're guaranteed that there isn't already a device on the list with the same
     //  address.  If we receive the same device announce again - it is considered
@@ -820,6 +826,8 @@ void ConnectorImpl::discoveryLostDevice(const Address & address)
 {
     DeviceImpl * existingDev = findDeviceInList(address);
 
+    invalidateModePossibleCache();
+
     if (!existingDev)
     {
         DP_ASSERT(0 && "Device lost on device not in database?!");
@@ -1225,10 +1233,11 @@ bool ConnectorImpl::compoundQueryAttach(Group * target,
                 warData.dpData.hBlank = modesetParams.modesetInfo.rasterWidth - modesetParams.modesetInfo.surfaceWidth;
                 warData.connectorType = DSC_DP;
 
-                if ((DSC_GeneratePPS(&dscInfo, &modesetInfoDSC,
-                                     &warData, availableBandwidthBitsPerSecond,
-                                     (NvU32*)(PPS),
-                                     (NvU32*)(&bitsPerPixelX16))) != NVT_STATUS_SUCCESS)
+                if ((DSC_GeneratePPSWithWorkspace(&dscInfo, &modesetInfoDSC,
+                                                  &warData, availableBandwidthBitsPerSecond,
+                                                  (NvU32*)(PPS),
+                                                  (NvU32*)(&bitsPerPixelX16),
+                                                  &dscPpsWorkspace)) != NVT_STATUS_SUCCESS)
                 {
                     if (pDscParams->forceDsc == DSC_FORCE_ENABLE)
                     {
@@ -1307,21 +1316,9 @@ nonDscDpIMP:
             compoundQueryResult = false;
 
         //      Verify the min blanking, etc
-        Watermark dpinfo;
-
-        if (this->isFECSupported())
+        if (!isModePossibleCached(lc, localModesetInfo, true))
         {
-            if (!isModePossibleMSTWithFEC(lc, localModesetInfo, &dpinfo))
-            {
-                compoundQueryResult = false;
-            }
-        }
-        else
-        {
-            if (!isModePossibleMST(lc, localModesetInfo, &dpinfo))
-            {
-                compoundQueryResult = false;
-            }
+            compoundQueryResult = false;
         }
 
         for(Device * d = target->enumDevices(0); d; d = target->enumDevices(d))
@@ -1457,10 +1454,11 @@ nonDscDpIMP:
                     warData.dpData.dpMode = DSC_DP_SST;
                     warData.connectorType = DSC_DP;
 
-                    if ((DSC_GeneratePPS(&dscInfo, &modesetInfoDSC,
-                                         &warData, availableBandwidthBitsPerSecond,
-                                         (NvU32*)(PPS),
-                                         (NvU32*)(&bitsPerPixelX16))) != NVT_STATUS_SUCCESS)
+                    if ((DSC_GeneratePPSWithWorkspace(&dscInfo, &modesetInfoDSC,
+                                                      &warData, availableBandwidthBitsPerSecond,
+                                                      (NvU32*)(PPS),
+                                                      (NvU32*)(&bitsPerPixelX16),
+                                                      &dscPpsWorkspace)) != NVT_STATUS_SUCCESS)
                     {
                         compoundQueryResult = false;
                         pDscParams->bEnableDsc = false;
@@ -3154,25 +3152,112 @@ bool ConnectorImpl::willLinkSupportModeSST(const LinkConfiguration & linkConfig,
     if (linkConfig.lanes == 0 || linkConfig.peakRate == 0)
         return false;
 
+    return isModePossibleCached(linkConfig, modesetInfo, false);
+}
+
+static bool modesetInfoEqual(const ModesetInfo & a, const ModesetInfo & b)
+{
+    return a.twoChannelAudioHz == b.twoChannelAudioHz &&
+           a.eightChannelAudioHz == b.eightChannelAudioHz &&
+           a.pixelClockHz == b.pixelClockHz &&
+           a.rasterWidth == b.rasterWidth &&
+           a.rasterHeight == b.rasterHeight &&
+           a.surfaceWidth == b.surfaceWidth &&
+           a.surfaceHeight == b.surfaceHeight &&
+           a.depth == b.depth &&
+           a.rasterBlankStartX == b.rasterBlankStartX &&
+           a.rasterBlankEndX == b.rasterBlankEndX &&
+           a.bitsPerComponent == b.bitsPerComponent &&
+           a.bEnableDsc == b.bEnableDsc &&
+           a.mode == b.mode;
+}
+
+//
+// The watermark calculations only read these LinkConfiguration fields.
+//
+static bool watermarkLinkConfigEqual(const LinkConfiguration & a, const LinkConfiguration & b)
+{
+    return a.lanes == b.lanes &&
+           a.peakRate == b.peakRate &&
+           a.minRate == b.minRate &&
+           a.enhancedFraming == b.enhancedFraming &&
+           a.multistream == b.multistream &&
+           a.bEnableFEC == b.bEnableFEC;
+}
+
+//
+// Run the SST or MST watermark check for this mode and link configuration.
+// Mode validation repeats the same queries for every head and candidate link
+// configuration, so results are kept in a small direct-mapped cache.
+//
+bool ConnectorImpl::isModePossibleCached(const LinkConfiguration & linkConfig, const ModesetInfo & modesetInfo, bool bMultistream)
+{
+    NvU64 hash = modesetInfo.pixelClockHz;
+    hash = hash * 31 + modesetInfo.rasterWidth;
+    hash = hash * 31 + modesetInfo.rasterHeight;
+    hash = hash * 31 + modesetInfo.surfaceWidth;
+    hash = hash * 31 + modesetInfo.depth;
+    hash = hash * 31 + linkConfig.lanes;
+    hash = hash * 31 + linkConfig.peakRate;
+    hash = hash * 31 + (linkConfig.bEnableFEC ? 1 : 0);
+    hash = hash * 31 + (bMultistream ? 1 : 0);
+    hash ^= hash >> 32;
+    hash ^= hash >> 16;
+
+    ModePossibleCacheEntry & entry = modePossibleCache[hash & (modePossibleCacheSize - 1)];
+    const bool bFECSupported = this->isFECSupported();
+    const bool bIncreasedWatermarkLimits = main->hasIncreasedWatermarkLimits();
+
+    if (entry.valid &&
+        entry.bMultistream == bMultistream &&
+        entry.bFECSupported == bFECSupported &&
+        entry.bIncreasedWatermarkLimits == bIncreasedWatermarkLimits &&
+        watermarkLinkConfigEqual(entry.linkConfig, linkConfig) &&
+        modesetInfoEqual(entry.modesetInfo, modesetInfo))
+    {
+        modePossibleCacheHits++;
+        return entry.bPossible;
+    }
+
+    modePossibleCacheMisses++;
+
     Watermark water;
+    bool bPossible;
 
-    if (this->isFECSupported())
+    if (bMultistream)
     {
-        if (!isModePossibleSSTWithFEC(linkConfig, modesetInfo, &water, main->hasIncreasedWatermarkLimits()))
-        {
-            // Verify audio
-            return false;
-        }
+        if (bFECSupported)
+            bPossible = isModePossibleMSTWithFEC(linkConfig, modesetInfo, &water);
+        else
+            bPossible = isModePossibleMST(linkConfig, modesetInfo, &water);
     }
     else
     {
-        if (!isModePossibleSST(linkConfig, modesetInfo, &water, main->hasIncreasedWatermarkLimits()))
-        {
-            // Verify audio
-            return false;
-        }
+        if (bFECSupported)
+            bPossible = isModePossibleSSTWithFEC(linkConfig, modesetInfo, &water, bIncreasedWatermarkLimits);
+        else
+            bPossible = isModePossibleSST(linkConfig, modesetInfo, &water, bIncreasedWatermarkLimits);
     }
-    return true;
+
+    entry.valid = true;
+    entry.bMultistream = bMultistream;
+    entry.bFECSupported = bFECSupported;
+    entry.bIncreasedWatermarkLimits = bIncreasedWatermarkLimits;
+    entry.bPossible = bPossible;
+    entry.linkConfig = linkConfig;
+    entry.modesetInfo = modesetInfo;
+
+    return bPossible;
+}
+
+//
+// Drop all memoized watermark results.  Called whenever GPU capabilities, the
+// link configuration or the topology change.
+//
+void ConnectorImpl::invalidateModePossibleCache()
+{
+    for (unsigned i = 0; i < modePossibleCacheSize; i++)
+        modePossibleCache[i].valid = false;
 }
 
 // gets max values for DPCD HAL and forces link trainig with that config
@@ -4519,6 +4604,8 @@ bool ConnectorImpl::train(const LinkConfiguration & lConfig, bool force,
             return false;
     }
 
+    invalidateModePossibleCache();
+
     if (!lConfig.multistream)
     {
           for (Device * i = enumDevices(0); i; i=enumDevices(i))
@@ -5468,6 +5555,7 @@ void ConnectorImpl::notifyLongPulseInternal(bool statusConnected)
 {
     // start from scratch
     preferredLinkConfig = LinkConfiguration();
+    invalidateModePossibleCache();
 
     bPConConnected = false;
     bSkipAssessLinkForPCon = false;
@@ -6763,6 +6851,7 @@ void ConnectorImpl::notifyGPUCapabilityChange()
     // Query current GPU capabilities.
     main->queryGPUCapability();
 
+    invalidateModePossibleCache();
 }
 
 void ConnectorImpl::notifyHBR2WAREngage()
@@ -79,40 +79,109 @@ void DiscoveryManager::detectSink(DiscoveryManager::Device device, bool bFromCSN
     sinkDetection->start();
 }
 
-DiscoveryManager::Device * DiscoveryManager::findDevice(const Address & address)
+static unsigned hashAddress(const Address & address)
+{
+    unsigned hash = address.size();
+
+    for (unsigned i = 0; i < address.size(); i++)
+        hash = hash * 31 + address[i];
+
+    return hash;
+}
+
+static unsigned hashGuid(const GUID & guid)
 {
+    unsigned hash = 2166136261u;    // FNV-1a
+
+    for (unsigned i = 0; i < DPCD_GUID_SIZE; i++)
+        hash = (hash ^ guid.data[i]) * 16777619u;
+
+    return hash;
+}
+
+void DiscoveryManager::indexDevice(unsigned deviceIndex)
+{
+    Device & device = currentDevices[deviceIndex];
+    unsigned slot;
+
+    for (slot = hashAddress(device.address) & (deviceIndexSize - 1);
+         addressIndex[slot];
+         slot = (slot + 1) & (deviceIndexSize - 1))
+        ;
+    addressIndex[slot] = (NvU8)(deviceIndex + 1);
+
+    if (device.peerGuid.isGuidZero())
+        return;
+
+    for (slot = hashGuid(device.peerGuid) & (deviceIndexSize - 1);
+         guidIndex[slot];
+         slot = (slot + 1) & (deviceIndexSize - 1))
+        ;
+    guidIndex[slot] = (NvU8)(deviceIndex + 1);
+}
+
+void DiscoveryManager::rebuildDeviceIndices()
+{
+    dpMemZero(addressIndex, sizeof(addressIndex));
+    dpMemZero(guidIndex, sizeof(guidIndex));
+
     for (unsigned i = 0; i < currentDevicesCount; i++)
-        if (currentDevices[i].address == address)
+        indexDevice(i);
+}
+
+DiscoveryManager::Device * DiscoveryManager::findDevice(const Address & address)
+{
+    Device * found = 0;
+
+    //
+    // Duplicate addresses aren't expected, but if present the lowest entry
+    // wins, as it did when currentDevices was scanned in order.
+    //
+    for (unsigned slot = hashAddress(address) & (deviceIndexSize - 1);
+         addressIndex[slot];
+         slot = (slot + 1) & (deviceIndexSize - 1))
+    {
+        Device * device = &currentDevices[addressIndex[slot] - 1];
+        if (device->address == address && (!found || device < found))
+            found = device;
+    }
+
+    if (found)
+    {
+        if (found->peerGuid.isGuidZero() && found->peerDevice != Dongle &&
+            (found->dpcdRevisionMajor >= 1 && found->dpcdRevisionMinor >= 2))
         {
-            if (currentDevices[i].peerGuid.isGuidZero() && currentDevices[i].peerDevice != Dongle &&
-                (currentDevices[i].dpcdRevisionMajor >= 1 && currentDevices[i].dpcdRevisionMinor >= 2))
-            {
-                DP_ASSERT(0 && "Zero guid for device even though its not a dongle type.");
-            }
-            return &currentDevices[i];
+            DP_ASSERT(0 && "Zero guid for device even though its not a dongle type.");
         }
+    }
 
-    return 0;
+    return found;
 }
 
 DiscoveryManager::Device * DiscoveryManager::findDevice(GUID & guid)
 {
+    Device * found = 0;
+
     if (guid.isGuidZero())
     {
         DP_ASSERT(0 && "zero guid search");
         return 0;
     }
 
-    for (unsigned i = 0; i < currentDevicesCount; i++)
+    for (unsigned slot = hashGuid(guid) & (deviceIndexSize - 1);
+         guidIndex[slot];
+         slot = (slot + 1) & (deviceIndexSize - 1))
     {
-        if (currentDevices[i].dpcdRevisionMajor <= 1 && currentDevices[i].dpcdRevisionMinor < 2)
+        Device * device = &currentDevices[guidIndex[slot] - 1];
+
+        if (device->dpcdRevisionMajor <= 1 && device->dpcdRevisionMinor < 2)
             continue;
 
-        if (currentDevices[i].peerGuid == guid)
-            return &currentDevices[i];
+        if (device->peerGuid == guid && (!found || device < found))
+            found = device;
     }
 
-    return 0;
+    return found;
 }
 
 void DiscoveryManager::addDevice(const DiscoveryManager::Device & device)
@@ -143,34 +212,61 @@ void DiscoveryManager::addDevice(const DiscoveryManager::Device & device)
 
     if (currentDevicesCount < maximumTopologyNodes)
     {
-        currentDevices[currentDevicesCount++] = device;
+        currentDevices[currentDevicesCount] = device;
+        indexDevice(currentDevicesCount++);
     }
 }
 
-void DiscoveryManager::removeDevice(Device * device)
+void DiscoveryManager::notifyLostDevice(const Device & device)
 {
     Address::StringBuffer sb;
     DP_USED(sb);
 
-    DP_LOG(("DP-DM> Lost device '%s' %s %s %s", device->address.toString(sb),
-            device->branch ? "Branch" : "", device->legacy ? "Legacy" : "",
-            device->peerDevice == Dongle ? "Dongle" :
-            device->peerDevice == DownstreamSink ? "DownstreamSink" : ""));
+    DP_LOG(("DP-DM> Lost device '%s' %s %s %s", device.address.toString(sb),
+            device.branch ? "Branch" : "", device.legacy ? "Legacy" : "",
+            device.peerDevice == Dongle ? "Dongle" :
+            device.peerDevice == DownstreamSink ? "DownstreamSink" : ""));
 
-    sink->discoveryLostDevice(device->address);
+    sink->discoveryLostDevice(device.address);
+}
+
+void DiscoveryManager::removeDevice(Device * device)
+{
+    notifyLostDevice(*device);
 
     for (unsigned i = (unsigned)(device-&currentDevices[0]); i < currentDevicesCount - 1; i++)
         currentDevices[i] = currentDevices[i+1];
     currentDevicesCount--;
+
+    rebuildDeviceIndices();
 }
 
+//
+//  Remove every device at or below 'prefix', reporting them in table order,
+//  and compact the table in a single pass.
+//
 void DiscoveryManager::removeDeviceTree(const Address & prefix)
 {
-    for (unsigned i = 0; i < currentDevicesCount;)
+    unsigned kept = 0;
+
+    for (unsigned i = 0; i < currentDevicesCount; i++)
+    {
         if (currentDevices[i].address.under(prefix))
-            removeDevice(&currentDevices[i]);
-        else
-            i++;
+        {
+            notifyLostDevice(currentDevices[i]);
+            continue;
+        }
+
+        if (kept != i)
+            currentDevices[kept] = currentDevices[i];
+        kept++;
+    }
+
+    if (kept != currentDevicesCount)
+    {
+        currentDevicesCount = kept;
+        rebuildDeviceIndices();
+    }
 }
 
 DiscoveryManager::Device * DiscoveryManager::findChildDeviceForBranchWithGuid
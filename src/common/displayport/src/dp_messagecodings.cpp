@@ -400,10 +400,7 @@ ParseResponseStatus RemoteDpcdReadMessage::parseResponseAck(EncodedMessage * mes
     reader->readOrDefault(4 /*zeroes*/, 0);
     reply.portNumber = reader->readOrDefault(4 /*Port_Number*/, 0xF);
     reply.numBytesReadDPCD = reader->readOrDefault(8 /*Num_Of_Bytes_Read*/, 0x0);
-    for (unsigned i=0; i<reply.numBytesReadDPCD; i++)
-    {
-        reply.readData[i] = (NvU8)reader->readOrDefault(8 /*data*/, 0x0);
-    }
+    reader->readBytes(reply.readData, reply.numBytesReadDPCD);
 
     if (this->getSinkPort() != reply.portNumber)
         return ParseResponseWrong;
@@ -437,10 +434,7 @@ void RemoteDpcdWriteMessage::set
     writer.write(dpcdAddress, 20);
     writer.write(nBytesToWrite, 8);
 
-    for (unsigned i=0; i<nBytesToWrite; i++)
-    {
-        writer.write(writeData[i], 8);
-    }
+    writer.writeBytes(writeData, nBytesToWrite);
 
     encodedMessage.isPathMessage = false;
     encodedMessage.isBroadcast  = false;
@@ -495,10 +489,7 @@ void RemoteI2cReadMessage::set
         writer.write(0/*zero*/, 1);
         writer.write(transactions[i].WriteI2cDeviceId, 7);
         writer.write(transactions[i].NumBytes, 8);
-        for(unsigned j=0; j<transactions[i].NumBytes; j++)
-        {
-            writer.write(transactions[i].I2cData[j], 8);
-        }
+        writer.writeBytes(transactions[i].I2cData, transactions[i].NumBytes);
         writer.write(0/*zeroes*/, 3);
         writer.write(transactions[i].NoStopBit ? 1 : 0, 1);
         writer.write(transactions[i].I2cTransactionDelay, 4);
@@ -518,10 +509,7 @@ ParseResponseStatus RemoteI2cReadMessage::parseResponseAck(EncodedMessage * mess
     reader->readOrDefault(4 /*zeroes*/, 0);
     reply.portNumber = reader->readOrDefault(4 /*Port_Number*/, 0xF);
     reply.numBytesReadI2C = reader->readOrDefault(8 /*Num_Of_Bytes_Read*/, 0x0);
-    for (unsigned i=0; i<reply.numBytesReadI2C; i++)
-    {
-        reply.readData[i] = (NvU8)reader->readOrDefault(8 /*data*/, 0x0);
-    }
+    reader->readBytes(reply.readData, reply.numBytesReadI2C);
 
     if (this->getSinkPort() != reply.portNumber)
         return ParseResponseWrong;
@@ -557,10 +545,7 @@ void RemoteI2cWriteMessage::set
     writer.write(writeI2cDeviceId, 7);
     writer.write(nBytesToWrite, 8);
 
-    for (unsigned i=0; i<nBytesToWrite; i++)
-    {
-        writer.write(writeData[i], 8);
-    }
+    writer.writeBytes(writeData, nBytesToWrite);
 
     encodedMessage.isPathMessage = false;
     encodedMessage.isBroadcast  = false;
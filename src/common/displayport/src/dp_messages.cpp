@@ -94,18 +94,7 @@ bool MessageManager::send(MessageManager::Message * message, NakData & nakData)
 
 bool DisplayPort::extractGUID(BitStreamReader * reader, GUID * guid)
 {
-    for (unsigned i=0; i < 128; i += 8)
-    {
-        unsigned data;
-        if (!reader->read(&data, 8))
-        {
-            return false;
-        }
-
-        guid->data[i/8] = (NvU8)data;
-    }
-
-    return true;
+    return reader->readBytes(guid->data, sizeof(guid->data));
 }
 
 void  MessageManager::messagedReceived(IncomingTransactionManager * from, EncodedMessage * message)
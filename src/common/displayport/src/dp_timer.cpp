@@ -30,6 +30,148 @@
 #include "dp_timer.h"
 using namespace DisplayPort;
 
+static inline bool callbackBefore(const NvU64 aTimestamp, const NvU64 aSequence,
+                                  const NvU64 bTimestamp, const NvU64 bSequence)
+{
+    return (aTimestamp < bTimestamp) ||
+           (aTimestamp == bTimestamp && aSequence < bSequence);
+}
+
+#define PENDING_BEFORE(a, b) \
+    callbackBefore((a)->timestamp, (a)->sequence, (b)->timestamp, (b)->sequence)
+
+bool Timer::CallbackHeap::push(PendingCallback * callback)
+{
+    if (count == capacity)
+    {
+        unsigned newCapacity = capacity ? capacity * 2 : 16;
+        PendingCallback ** newItems =
+            (PendingCallback **)dpMalloc(newCapacity * sizeof(PendingCallback *));
+        if (!newItems)
+            return false;
+
+        if (items)
+        {
+            dpMemCopy(newItems, items, count * sizeof(PendingCallback *));
+            dpFree(items);
+        }
+        items = newItems;
+        capacity = newCapacity;
+    }
+
+    items[count] = callback;
+    siftUp(count++);
+    return true;
+}
+
+Timer::PendingCallback * Timer::CallbackHeap::pop()
+{
+    PendingCallback * first;
+
+    if (!count)
+        return 0;
+
+    first = items[0];
+    items[0] = items[--count];
+    if (count)
+        siftDown(0);
+    return first;
+}
+
+void Timer::CallbackHeap::siftUp(unsigned index)
+{
+    PendingCallback * callback = items[index];
+
+    while (index)
+    {
+        unsigned parent = (index - 1) / 2;
+        if (!PENDING_BEFORE(callback, items[parent]))
+            break;
+        items[index] = items[parent];
+        index = parent;
+    }
+    items[index] = callback;
+}
+
+void Timer::CallbackHeap::siftDown(unsigned index)
+{
+    PendingCallback * callback = items[index];
+
+    for (;;)
+    {
+        unsigned child = 2 * index + 1;
+        if (child >= count)
+            break;
+        if (child + 1 < count && PENDING_BEFORE(items[child + 1], items[child]))
+            child++;
+        if (!PENDING_BEFORE(items[child], callback))
+            break;
+        items[index] = items[child];
+        index = child;
+    }
+    items[index] = callback;
+}
+
+Timer::~Timer()
+{
+    CallbackHeap * heaps[] = { &sleepPending, &wakePending };
+
+    for (unsigned h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++)
+    {
+        for (unsigned i = 0; i < heaps[h]->count; i++)
+            dpFree(heaps[h]->items[i]);
+        dpFree(heaps[h]->items);
+    }
+
+    while (freeCallbacks)
+    {
+        PendingCallback * callback = freeCallbacks;
+        freeCallbacks = callback->nextFree;
+        dpFree(callback);
+    }
+}
+
+Timer::PendingCallback * Timer::allocCallback()
+{
+    PendingCallback * callback = freeCallbacks;
+
+    if (callback)
+        freeCallbacks = callback->nextFree;
+    else
+        callback = (PendingCallback *)dpMalloc(sizeof(PendingCallback));
+
+    if (callback)
+        dpMemZero(callback, sizeof(PendingCallback));
+
+    return callback;
+}
+
+void Timer::freeCallback(PendingCallback * callback)
+{
+    callback->nextFree = freeCallbacks;
+    freeCallbacks = callback;
+}
+
+//
+//  Returns the earliest pending callback that may run in this context, and the
+//  heap it lives in.  Callbacks that don't execute in sleep are skipped when
+//  called from sleep.
+//
+Timer::PendingCallback * Timer::nextPending(bool fromSleep, CallbackHeap ** heap)
+{
+    PendingCallback * sleepFirst = sleepPending.top();
+    PendingCallback * wakeFirst = fromSleep ? 0 : wakePending.top();
+
+    if (wakeFirst && (!sleepFirst || PENDING_BEFORE(wakeFirst, sleepFirst)))
+    {
+        *heap = &wakePending;
+        return wakeFirst;
+    }
+
+    *heap = &sleepPending;
+    return sleepFirst;
+}
+
 void Timer::expired()
 {
     fire(false);
@@ -40,39 +182,35 @@ void Timer::expired()
 //   Clients may sleep in response to a timer callback.
 unsigned Timer::fire(bool fromSleep) // returns min time to next item to be fired
 {
-    restart:
-
-    NvU64 now = getTimeUs();
-    NvU64 nearest = (NvU64)-1;
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); )
+    for (;;)
     {
-        if (fromSleep && !i->executeInSleep) {
-            i = (PendingCallback*)i->next;
-            continue;
-        }
+        NvU64 now = getTimeUs();
+        NvU64 nearest = (NvU64)-1;
+        CallbackHeap * heap;
+        PendingCallback * i = nextPending(fromSleep, &heap);
 
-        if (now >= i->timestamp)
+        if (i && now >= i->timestamp)
         {
             const void * context = i->context;
             TimerCallback * target = i->target;
-            delete i;
+            heap->pop();
+            freeCallback(i);
             if (target)
                 target->expired(context);           // Take care, the client may have made
                                                     // a recursive call to fire in here.
-                                                    // Easy solution: Restart at front of list.
-                                                    //    current time may have also changed
-                                                    //    drastically from a nested sleep
-            goto restart;
-        }
-        else
-        {
-            if (i->timestamp < nearest)
-                nearest = i->timestamp;
-            i = (PendingCallback*)i->next;
+                                                    // The callback was popped first, and
+                                                    // the heap top is re-read each pass;
+                                                    // the current time may also have
+                                                    // changed drastically from a nested sleep
+            continue;
         }
+
+        if (i)
+            nearest = i->timestamp;
+
+        unsigned minleft = (unsigned)((nearest - now + 999)/ 1000);
+        return minleft;
     }
-    unsigned minleft = (unsigned)((nearest - now + 999)/ 1000);
-    return minleft;
 }
 
 void Timer::_pump(unsigned milliseconds, bool fromSleep) 
@@ -96,7 +234,7 @@ void Timer::_pump(unsigned milliseconds, bool fromSleep)
 void Timer::queueCallback(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep) 
 {
     NvU64 now = getTimeUs();
-    PendingCallback * callback = new PendingCallback();
+    PendingCallback * callback = allocCallback();
     if (callback == NULL)
     {
         DP_LOG(("DP> %s: Failed to allocate callback",
@@ -106,8 +244,15 @@ void Timer::queueCallback(Timer::TimerCallback * target, const  void * context,
     callback->target = target;
     callback->context = context;
     callback->timestamp = now + milliseconds * 1000;
+    callback->sequence = nextSequence++;
     callback->executeInSleep = executeInSleep;
-    pending.insertBack(callback);
+    if (!(executeInSleep ? sleepPending : wakePending).push(callback))
+    {
+        DP_LOG(("DP> %s: Failed to queue callback",
+                    __FUNCTION__));
+        freeCallback(callback);
+        return;
+    }
     raw->queueCallback(this, milliseconds);
 }
 
@@ -123,77 +268,71 @@ void Timer::sleep(unsigned milliseconds)
     _pump(milliseconds, true);
 }
 
+//
+//  Cancelled callbacks stay queued with a NULL target until they expire, as
+//  the cancel functions may be called from within a callback.
+//
 void Timer::cancelCallbacks(Timer::TimerCallback * to) 
 {
+    CallbackHeap * heaps[] = { &sleepPending, &wakePending };
+
     if (!to)
         return;
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        if (i->target == to)
-            i->target = 0;
+    for (unsigned h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++)
+        for (unsigned i = 0; i < heaps[h]->count; i++)
+            if (heaps[h]->items[i]->target == to)
+                heaps[h]->items[i]->target = 0;
 }
 
 void Timer::cancelCallback(Timer::TimerCallback * to, const void * context) 
 {
+    CallbackHeap * heaps[] = { &sleepPending, &wakePending };
+
     if (!to)
         return;
-    for (PendingCallback * i = (PendingCallback *)pending.begin(); i!=pending.end(); i = (PendingCallback*)i->next)
-        if (i->target == to && i->context == context) 
-            i->target = 0;
+    for (unsigned h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++)
+        for (unsigned i = 0; i < heaps[h]->count; i++)
+            if (heaps[h]->items[i]->target == to && heaps[h]->items[i]->context == context)
+                heaps[h]->items[i]->target = 0;
 }
 
-// Queue callbacks in order.
+//
+//  Queue callbacks in order.
+//      Callbacks already fire in (timestamp, queue order) order, so a callback
+//      never fires ahead of an earlier-expiring one for the same context.
+//
 void Timer::queueCallbackInOrder(Timer::TimerCallback * target, const  void * context, unsigned milliseconds, bool executeInSleep) 
 {
-    NvU64 now = getTimeUs();
-    PendingCallback * callback = new PendingCallback();
-    callback->target = target;
-    callback->context = context;
-    callback->timestamp = now + milliseconds * 1000;
-    callback->executeInSleep = executeInSleep;
-
-    //Figure out where to insert the current callback
-    Timer::PendingCallback* i;
-
-    for (i = (PendingCallback*)pending.begin(); i != pending.end();)
-    {
-        // only for the given context.
-        if(i->context == context)
-        {
-            if(i->timestamp > callback->timestamp)
-                break;
-        }
-        i = (PendingCallback*) i->next;
-    }
-    if (i == pending.end())
-    {
-        pending.insertBack(callback);
-    }
-    else 
-    {
-        pending.insertBefore(i, callback);
-    }
-
-    raw->queueCallback(this, milliseconds);
+    queueCallback(target, context, milliseconds, executeInSleep);
 }
 
 void Timer::cancelAllCallbacks()
 {
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        i->target = 0;
+    CallbackHeap * heaps[] = { &sleepPending, &wakePending };
+
+    for (unsigned h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++)
+        for (unsigned i = 0; i < heaps[h]->count; i++)
+            heaps[h]->items[i]->target = 0;
 }
 
 void Timer::cancelCallbacksWithoutContext(const  void * context)
 {
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        if(i->context != context)
-            i->target = 0;
+    CallbackHeap * heaps[] = { &sleepPending, &wakePending };
+
+    for (unsigned h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++)
+        for (unsigned i = 0; i < heaps[h]->count; i++)
+            if (heaps[h]->items[i]->context != context)
+                heaps[h]->items[i]->target = 0;
 }
 
 bool Timer::checkCallbacksOfSameContext(const void * context)
 {
-    for (PendingCallback * i = (PendingCallback*)pending.begin(); i!=pending.end(); i = (PendingCallback *)i->next)
-        if(i->context == context)
-            return true;
+    CallbackHeap * heaps[] = { &sleepPending, &wakePending };
+
+    for (unsigned h = 0; h < sizeof(heaps) / sizeof(heaps[0]); h++)
+        for (unsigned i = 0; i < heaps[h]->count; i++)
+            if (heaps[h]->items[i]->context == context)
+                return true;
 
     return false;
 }
@@ -178,11 +178,14 @@ extern NVLOG_LOGGER NvLogLogger;
 // STATE - Lock only during state change, do memory copying unlocked
 //         Don't use with tiny buffers that overflow every write or two.
 // FULL  - Keep everything locked for the full duration of the write
+// LOCKFREE - Reserve space with an atomic compare-and-swap on pos, do memory
+//         copying unlocked. Same restrictions as STATE; cannot be expanded.
 //
 #define NVLOG_BUFFER_FLAGS_LOCKING                      6:5
 #define NVLOG_BUFFER_FLAGS_LOCKING_NONE                  0
 #define NVLOG_BUFFER_FLAGS_LOCKING_STATE                 1
 #define NVLOG_BUFFER_FLAGS_LOCKING_FULL                  2
+#define NVLOG_BUFFER_FLAGS_LOCKING_LOCKFREE              3
 
 // Store this buffer in OCA minidumps
 #define NVLOG_BUFFER_FLAGS_OCA                          7:7
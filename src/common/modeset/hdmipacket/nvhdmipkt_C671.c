@@ -631,6 +631,118 @@ static void calcBppMinMax(HDMI_SRC_CAPS               const *pSrcCaps,
 }
 
 
+static NvBool
+frlCapacityParamsEqual(NV0073_CTRL_FRL_CAPACITY_COMPUTATION_PARAMS const *pA,
+                       NV0073_CTRL_FRL_CAPACITY_COMPUTATION_PARAMS const *pB)
+{
+    NvU8 const *a = (NvU8 const *)pA;
+    NvU8 const *b = (NvU8 const *)pB;
+    NvU32 i;
+
+    for (i = 0; i < sizeof(*pA); i++)
+    {
+        if (a[i] != b[i])
+        {
+            return NV_FALSE;
+        }
+    }
+
+    return NV_TRUE;
+}
+
+// Run the compressed video capacity computation for pFRLParams, consulting the class's
+// LRU cache first. The computation is a pure function of its input, and the same inputs
+// recur when a modepool is validated for several heads or when a query is refined.
+static NVHDMIPKT_RESULT
+queryCompressedCapacity(NVHDMIPKT_CLASS                             *pThis,
+                        NV0073_CTRL_FRL_CAPACITY_COMPUTATION_PARAMS *pFRLParams,
+                        NV0073_CTRL_FRL_CAPACITY_COMPUTATION_RESULT *pResults)
+{
+    NVHDMIPKT_FRL_CAPACITY_CACHE_ENTRY *pEntry  = NULL;
+    NVHDMIPKT_FRL_CAPACITY_CACHE_ENTRY *pVictim = &pThis->frlCapacityCache[0];
+    NvBool bComputed = NV_FALSE;
+    NvU32 i;
+
+    pThis->callback.acquireMutex(pThis->cbHandle);
+    for (i = 0; i < NVHDMIPKT_FRL_CAPACITY_CACHE_SIZE; i++)
+    {
+        NVHDMIPKT_FRL_CAPACITY_CACHE_ENTRY *pCur = &pThis->frlCapacityCache[i];
+
+        if (pCur->bValid && frlCapacityParamsEqual(&pCur->input, pFRLParams))
+        {
+            pEntry = pCur;
+            break;
+        }
+
+        if (pVictim->bValid && (!pCur->bValid || (pCur->lastUse < pVictim->lastUse)))
+        {
+            pVictim = pCur;
+        }
+    }
+
+    if (pEntry)
+    {
+        pEntry->lastUse = ++pThis->frlCapacityCacheClock;
+        *pResults = pEntry->result;
+    }
+    pThis->callback.releaseMutex(pThis->cbHandle);
+
+    if (pEntry == NULL)
+    {
+#if defined(WINNT)
+        capacityComputationCompressedVideo(pFRLParams, pResults);
+        bComputed = NV_TRUE;
+#else
+        NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS *pGetHdmiFrlCapacityComputationParams =
+            pThis->callback.malloc(pThis->cbHandle, sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS));
+
+        if (pGetHdmiFrlCapacityComputationParams == NULL)
+        {
+            return NVHDMIPKT_FAIL;
+        }
+
+        NVMISC_MEMSET(pGetHdmiFrlCapacityComputationParams, 0, sizeof(*pGetHdmiFrlCapacityComputationParams));
+        pGetHdmiFrlCapacityComputationParams->input = *pFRLParams;
+        pGetHdmiFrlCapacityComputationParams->cmd = NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_CMD_COMPRESSED_VIDEO;
+#if NVHDMIPKT_RM_CALLS_INTERNAL
+        if (CALL_DISP_RM(NvRmControl)(pThis->clientHandles.hClient,
+                        pThis->clientHandles.hDisplay,
+                        NV0073_CTRL_CMD_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION,
+                        pGetHdmiFrlCapacityComputationParams,
+                        sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS)) == NVOS_STATUS_SUCCESS)
+#else // !NVHDMIPKT_RM_CALLS_INTERNAL
+        NvBool bSuccess = pThis->callback.rmDispControl2(pThis->cbHandle,
+                          0,
+                          NV0073_CTRL_CMD_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION, 
+                          pGetHdmiFrlCapacityComputationParams, 
+                          sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS));
+        if (bSuccess == NV_TRUE)
+#endif // NVHDMIPKT_RM_CALLS_INTERNAL
+        {
+            *pResults = pGetHdmiFrlCapacityComputationParams->result;
+            bComputed = NV_TRUE;
+        }
+
+        pThis->callback.free(pThis->cbHandle, pGetHdmiFrlCapacityComputationParams);
+#endif
+
+        if (!bComputed)
+        {
+            return NVHDMIPKT_INSUFFICIENT_BANDWIDTH;
+        }
+
+        pThis->callback.acquireMutex(pThis->cbHandle);
+        pVictim->bValid  = NV_TRUE;
+        pVictim->lastUse = ++pThis->frlCapacityCacheClock;
+        pVictim->input   = *pFRLParams;
+        pVictim->result  = *pResults;
+        pThis->callback.releaseMutex(pThis->cbHandle);
+    }
+
+    return (pResults->isVideoTransportSupported && pResults->isAudioSupported) ?
+           NVHDMIPKT_SUCCESS : NVHDMIPKT_INSUFFICIENT_BANDWIDTH;
+}
+
 // Determine minimum FRL rate at which Video Transport is possible at given min bpp
 // Once FRL rate is found, determine the max bpp possible at this FRL rate
 // To determine Primary Compressed Format using this function caller must pass in the full range of min, max FRL and min, max Bpp
@@ -645,56 +757,23 @@ determineCompressedFRLConfig(NVHDMIPKT_CLASS                             *pThis,
                              NvU32                                        bppMaxX16,
                              NV0073_CTRL_FRL_CAPACITY_COMPUTATION_RESULT *pResults)
 {
-#if !defined(WINNT)
-    NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS *pGetHdmiFrlCapacityComputationParams = NULL;
-#endif
+    NV0073_CTRL_FRL_CAPACITY_COMPUTATION_RESULT passResults;
     HDMI_FRL_DATA_RATE frlRate = minFRLRate;
-    NvU32 bppTargetX16         = bppMinX16;
+    NvU32 bppPassX16;
+    NvU32 bppFailX16;
     NVHDMIPKT_RESULT status = NVHDMIPKT_INSUFFICIENT_BANDWIDTH;
 
-#if !defined(WINNT)
-    pGetHdmiFrlCapacityComputationParams = pThis->callback.malloc(pThis->cbHandle, sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS));
-#endif
-
     // Set bppTarget to min and iterate over FRL rates
     pFRLParams->compressionInfo.bppTargetx16 = bppMinX16;
     while (frlRate != HDMI_FRL_DATA_RATE_NONE)
     {
         translateBitRate(frlRate, pFRLParams);
-#if defined(WINNT)
-        capacityComputationCompressedVideo(pFRLParams, pResults);
-#else
-        if (pGetHdmiFrlCapacityComputationParams)
-        {
-            NVMISC_MEMSET(pGetHdmiFrlCapacityComputationParams, 0, sizeof(*pGetHdmiFrlCapacityComputationParams));
-            pGetHdmiFrlCapacityComputationParams->input = *pFRLParams;
-            pGetHdmiFrlCapacityComputationParams->cmd = NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_CMD_COMPRESSED_VIDEO;
-#if NVHDMIPKT_RM_CALLS_INTERNAL
-            if (CALL_DISP_RM(NvRmControl)(pThis->clientHandles.hClient,
-                            pThis->clientHandles.hDisplay,
-                            NV0073_CTRL_CMD_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION,
-                            pGetHdmiFrlCapacityComputationParams,
-                            sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS)) == NVOS_STATUS_SUCCESS)
-#else // !NVHDMIPKT_RM_CALLS_INTERNAL
-            NvBool bSuccess = pThis->callback.rmDispControl2(pThis->cbHandle,
-                              0,
-                              NV0073_CTRL_CMD_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION, 
-                              pGetHdmiFrlCapacityComputationParams, 
-                              sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS));
-            if (bSuccess == NV_TRUE)
-#endif // NVHDMIPKT_RM_CALLS_INTERNAL
-            {
-                *pResults = pGetHdmiFrlCapacityComputationParams->result;
-            }
-        }
-        else
+
+        status = queryCompressedCapacity(pThis, pFRLParams, pResults);
+        if (status == NVHDMIPKT_FAIL)
         {
-            status = NVHDMIPKT_FAIL;
-            goto compressedQuery_exit;
+            return status;
         }
-#endif
-
-        status = (pResults->isVideoTransportSupported && pResults->isAudioSupported) ? NVHDMIPKT_SUCCESS : status;
 
         if ((status == NVHDMIPKT_SUCCESS) ||
             (frlRate == maxFRLRate))
@@ -707,88 +786,68 @@ determineCompressedFRLConfig(NVHDMIPKT_CLASS                             *pThis,
 
     if (status != NVHDMIPKT_SUCCESS)
     {
-        goto compressedQuery_exit;
+        return status;
     }
 
-    // We now have the base FRL rate. Iterate over bppTarget to find the max supported bpp
-    status = NVHDMIPKT_INSUFFICIENT_BANDWIDTH;
-    bppTargetX16 = bppMaxX16;
-    NvU32 stepSize = 16;
-
-    while (status != NVHDMIPKT_SUCCESS)
+    //
+    // We now have the base FRL rate, at which bppMin is known to work. Raising bppTarget
+    // only raises the bandwidth required, so find the max supported bpp by bisecting
+    // between the highest bpp known to pass and the lowest known to fail. Try bppMax
+    // first, as it is the common answer.
+    //
+    passResults = *pResults;
+    bppPassX16  = bppMinX16;
+    bppFailX16  = bppMaxX16 + 1;
+
+    if (bppMaxX16 > bppMinX16)
     {
-        pFRLParams->compressionInfo.bppTargetx16 = bppTargetX16;
-#if defined(WINNT)
-        capacityComputationCompressedVideo(pFRLParams, pResults);
-#else
-        if (pGetHdmiFrlCapacityComputationParams)
+        pFRLParams->compressionInfo.bppTargetx16 = bppMaxX16;
+        status = queryCompressedCapacity(pThis, pFRLParams, pResults);
+        if (status == NVHDMIPKT_FAIL)
         {
-            NVMISC_MEMSET(pGetHdmiFrlCapacityComputationParams, 0, sizeof(*pGetHdmiFrlCapacityComputationParams));
-            pGetHdmiFrlCapacityComputationParams->input = *pFRLParams;
-            pGetHdmiFrlCapacityComputationParams->cmd = NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_CMD_COMPRESSED_VIDEO;
-#if NVHDMIPKT_RM_CALLS_INTERNAL
-            if (CALL_DISP_RM(NvRmControl)(pThis->clientHandles.hClient,
-                            pThis->clientHandles.hDisplay,
-                            NV0073_CTRL_CMD_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION,
-                            pGetHdmiFrlCapacityComputationParams,
-                            sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS)) == NVOS_STATUS_SUCCESS)
-#else // !NVHDMIPKT_RM_CALLS_INTERNAL
-            NvBool bSuccess = pThis->callback.rmDispControl2(pThis->cbHandle,
-                              0,
-                              NV0073_CTRL_CMD_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION, 
-                              pGetHdmiFrlCapacityComputationParams, 
-                              sizeof(NV0073_CTRL_SPECIFIC_GET_HDMI_FRL_CAPACITY_COMPUTATION_PARAMS));
-            if (bSuccess == NV_TRUE)
-#endif // NVHDMIPKT_RM_CALLS_INTERNAL
-            {
-                *pResults = pGetHdmiFrlCapacityComputationParams->result;
-            }
+            return status;
+        }
+
+        if (status == NVHDMIPKT_SUCCESS)
+        {
+            passResults = *pResults;
+            bppPassX16  = bppMaxX16;
         }
         else
         {
-            status = NVHDMIPKT_FAIL;
-            goto compressedQuery_exit;
+            bppFailX16 = bppMaxX16;
         }
-#endif
+    }
 
-        status = (pResults->isVideoTransportSupported && pResults->isAudioSupported) ? NVHDMIPKT_SUCCESS : status;
+    while (bppFailX16 - bppPassX16 > 1)
+    {
+        NvU32 bppTargetX16 = bppPassX16 + (bppFailX16 - bppPassX16) / 2;
 
-        if (status == NVHDMIPKT_SUCCESS)
+        pFRLParams->compressionInfo.bppTargetx16 = bppTargetX16;
+        status = queryCompressedCapacity(pThis, pFRLParams, pResults);
+        if (status == NVHDMIPKT_FAIL)
         {
-            // If this is the maxBpp nothing else to try
-            if (bppTargetX16 == bppMaxX16)
-            {
-                break;
-            }
+            return status;
+        }
 
-            // If we detected a successful bppTarget value, go up a step size,
-            // and iterate by decrementing bppTarget by 1/16 to reach a finer tuned bpp value
-            if (stepSize == 16)
-            {
-                status = NVHDMIPKT_RETRY;
-                bppTargetX16 = bppTargetX16 + stepSize - 1;
-                stepSize = 1;
-            }
+        if (status == NVHDMIPKT_SUCCESS)
+        {
+            passResults = *pResults;
+            bppPassX16  = bppTargetX16;
         }
         else
         {
-            bppTargetX16 = bppTargetX16 - stepSize;
-            // bppTargetX16 is guaranteed to be >= bppMinX16
+            bppFailX16 = bppTargetX16;
         }
     }
 
-    pResults->frlRate = frlRate;
-    pResults->bppTargetx16 = bppTargetX16;
+    pFRLParams->compressionInfo.bppTargetx16 = bppPassX16;
+    *pResults = passResults;
 
-compressedQuery_exit:
-#if !defined(WINNT)
-    if (pGetHdmiFrlCapacityComputationParams)
-    {
-        pThis->callback.free(pThis->cbHandle, pGetHdmiFrlCapacityComputationParams);
-    }
-#endif
+    pResults->frlRate = frlRate;
+    pResults->bppTargetx16 = bppPassX16;
 
-    return status;
+    return NVHDMIPKT_SUCCESS;
 }
 
 /*
@@ -30,6 +30,7 @@
 
 #include "nvlimits.h"
 #include "nvhdmi_frlInterface.h"
+#include "ctrl/ctrl0073/ctrl0073specific.h"
 
 /*************************************************************************************************
  *            NOTE * This header file to be used only inside this (Hdmi Packet) library.         *
@@ -52,6 +53,18 @@ typedef enum
     NVHDMIPKT_INVALID_CLASS   // Not to be used by client, and always the last entry here.
 } NVHDMIPKT_CLASS_ID;
 
+// Number of compressed FRL capacity computation results remembered per class instance
+#define NVHDMIPKT_FRL_CAPACITY_CACHE_SIZE 16
+
+// Memoized FRL capacity computation, see hdmiQueryFRLConfigC671
+typedef struct _NVHDMIPKT_FRL_CAPACITY_CACHE_ENTRY
+{
+    NvBool                                      bValid;
+    NvU32                                       lastUse;
+    NV0073_CTRL_FRL_CAPACITY_COMPUTATION_PARAMS input;
+    NV0073_CTRL_FRL_CAPACITY_COMPUTATION_RESULT result;
+} NVHDMIPKT_FRL_CAPACITY_CACHE_ENTRY;
+
 // Hdmi packet class
 struct tagNVHDMIPKT_CLASS
 {
@@ -66,6 +79,10 @@ struct tagNVHDMIPKT_CLASS
     NVHDMIPKT_CALLBACK           callback;
     NVHDMIPKT_CLASS_ID           thisId;
     NvBool                       isRMCallInternal;
+
+    // LRU cache of compressed FRL capacity computations, protected by acquireMutex
+    NVHDMIPKT_FRL_CAPACITY_CACHE_ENTRY frlCapacityCache[NVHDMIPKT_FRL_CAPACITY_CACHE_SIZE];
+    NvU32                        frlCapacityCacheClock;
    
     // functions
     NVHDMIPKT_RESULT
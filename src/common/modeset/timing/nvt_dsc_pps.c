@@ -59,7 +59,7 @@
 #define MSB(a) (((a)>>8)&0xFF)
 #define LSB(a) ((a)&0xFF)
 
-#define NUM_BUF_RANGES 15
+#define NUM_BUF_RANGES DSC_NUM_BUF_RANGES
 #define BPP_UNIT 16
 #define OFFSET_FRACTIONAL_BITS  11
 #define PIXELS_PER_GROUP 3
@@ -87,88 +87,6 @@
 
 /* ------------------------ Datatypes -------------------------------------- */
 
-//input parameters to the pps calculation
-typedef struct
-{
-    NvU32  dsc_version_minor;     // DSC minor version (1-DSC1.1, 2-DSC 1.2)
-    NvU32  bits_per_component;    // bits per component of input pixels (8,10,12)
-    NvU32  linebuf_depth;         // bits per component of reconstructed line buffer (8 ~ 13)
-    NvU32  block_pred_enable;     // block prediction enable (0, 1)
-    NvU32  convert_rgb;           // input pixel format (0 YCbCr, 1 RGB)
-    NvU32  bits_per_pixel;        // bits per pixel*BPP_UNIT (8.0*BPP_UNIT ~ 32.0*BPP_UNIT)
-    NvU32  pic_height;            // picture height (8 ~ 8192)
-    NvU32  pic_width;             // picture width  (single mode: 32 ~ 5120, dual mode: 64 ~ 8192)
-    NvU32  slice_height;          // 0 - auto,   others (8 ~ 8192)  - must be (pic_height % slice_height == 0)
-    NvU32  slice_width;           // maximum slice_width, 0-- default: 1280.
-    NvU32  slice_num;             // 0 - auto,   others: 1,2,4,8
-    NvU32  slice_count_mask;      // no of slices supported by sink
-    NvU32  max_slice_num;         // slice number cap determined from GPU and sink caps
-    NvU32  max_slice_width;       // slice width cap determined from GPU and sink caps
-    NvU32  pixel_clkMHz;          // pixel clock frequency in MHz, used for slice_width calculation.
-    NvU32  dual_mode;             // 0 - single mode, 1 - dual mode, only for checking pic_width
-    NvU32  simple_422;            // 4:2:2 simple mode
-    NvU32  native_420;            // 420 native mode
-    NvU32  native_422;            // 422 native mode
-    NvU32  drop_mode;             // 0 - normal mode, 1 - drop mode.
-    NvU32  peak_throughput_mode0; // peak throughput supported by the sink for 444 and simple 422 modes. 
-    NvU32  peak_throughput_mode1; // peak throughput supported by the sink for native 422 and 420 modes.
-} DSC_INPUT_PARAMS;
-
-//output pps parameters after calculation
-typedef struct
-{
-    NvU32  dsc_version_major;                // DSC major version, always 1
-    NvU32  dsc_version_minor;                // DSC minor version
-    NvU32  pps_identifier;                   // Application-specific identifier, always 0
-    NvU32  bits_per_component;               // bits per component for input pixels
-    NvU32  linebuf_depth;                    // line buffer bit depth
-    NvU32  block_pred_enable;                // enable/disable block prediction
-    NvU32  convert_rgb;                      // color space for input pixels
-    NvU32  simple_422;                       // 4:2:2 simple mode
-    NvU32  vbr_enable;                       // enable VBR mode
-    NvU32  bits_per_pixel;                   // (bits per pixel * BPP_UNIT) after compression
-    NvU32  pic_height;                       // picture height
-    NvU32  pic_width;                        // picture width
-    NvU32  slice_height;                     // slice height
-    NvU32  slice_width;                      // slice width
-    NvU32  chunk_size;                       // the size in bytes of the slice chunks
-    NvU32  initial_xmit_delay;               // initial transmission delay
-    NvU32  initial_dec_delay;                // initial decoding delay
-    NvU32  initial_scale_value;              // initial xcXformScale factor value
-    NvU32  scale_increment_interval;         // number of group times between incrementing the rcXformScale factor
-    NvU32  scale_decrement_interval;         // number of group times between decrementing the rcXformScale factor
-    NvU32  first_line_bpg_offset;            // number of additional bits allocated for each group on the first line in a slice
-    NvU32  nfl_bpg_offset;                   // number of bits de-allocated for each group after the first line in a slice
-    NvU32  slice_bpg_offset;                 // number of bits de-allocated for each group to enforce the slice constrain
-    NvU32  initial_offset;                   // initial value for rcXformOffset
-    NvU32  final_offset;                     // maximum end-of-slice value for rcXformOffset
-    NvU32  flatness_min_qp;                  // minimum flatness QP
-    NvU32  flatness_max_qp;                  // maximum flatness QP
-    //rc_parameter_set
-    NvU32  rc_model_size;                    // number of bits within the "RC model"
-    NvU32  rc_edge_factor;                   // edge detection factor
-    NvU32  rc_quant_incr_limit0;             // QP threshold for short-term RC
-    NvU32  rc_quant_incr_limit1;             // QP threshold for short-term RC
-    NvU32  rc_tgt_offset_hi;                 // upper end of the target bpg range for short-term RC
-    NvU32  rc_tgt_offset_lo;                 // lower end of the target bpg range for short-term RC
-    NvU32  rc_buf_thresh[NUM_BUF_RANGES-1];  // thresholds in "RC model"
-    //rc_range_parameters
-    NvU32  range_min_qp[NUM_BUF_RANGES];     // minimum QP for each of the RC ranges
-    NvU32  range_max_qp[NUM_BUF_RANGES];     // maximum QP for each of the RC ranges
-    NvU32  range_bpg_offset[NUM_BUF_RANGES]; // bpg adjustment for each of the RC ranges
-    //420,422
-    NvU32  native_420;                       // 420 native mode
-    NvU32  native_422;                       // 422 native mode
-    NvU32  second_line_bpg_offset;           // 2nd line bpg offset to use, native 420 only
-    NvU32  nsl_bpg_offset;                   // non-2nd line bpg offset to use, native 420 only
-    NvU32  second_line_offset_adj;           // adjustment to 2nd line bpg offset, native 420 only
-
-    //additional params not in PPS
-    NvU32 slice_num;
-    NvU32 groups_per_line;
-    NvU32 num_extra_mux_bits;
-    NvU32 flatness_det_thresh;
-} DSC_OUTPUT_PARAMS;
 
 /* ------------------------ Global Variables ------------------------------- */
 
@@ -1336,10 +1254,11 @@ DSC_PpsCalc
  * @brief Calculate DSC_OUTPUT_PARAMS from DSC_INPUT_PARAMS internally,
  *        then pack pps parameters into 32bit data array. 
  *
- * @param[in]   in   DSC input parameter
- * @param[out]  out  DSC output parameter
- *                   NvU32[32] to return the pps data.
- *                   The data can be send to SetDscPpsData* methods directly.
+ * @param[in]   in       DSC input parameter
+ * @param[out]  pPpsOut  Scratch space for the calculated PPS parameters
+ * @param[out]  out      DSC output parameter
+ *                       NvU32[32] to return the pps data.
+ *                       The data can be send to SetDscPpsData* methods directly.
  *
  * @returns NVT_STATUS_SUCCESS if successful;
  *          NVT_STATUS_ERR if unsuccessful;
@@ -1348,34 +1267,22 @@ static NVT_STATUS
 DSC_PpsDataGen
 (
     const DSC_INPUT_PARAMS *in,
+    DSC_OUTPUT_PARAMS *pPpsOut,
     NvU32 out[DSC_MAX_PPS_SIZE_DWORD]
 )
 {
     NVT_STATUS ret;
-    DSC_OUTPUT_PARAMS *pPpsOut;
-
-    pPpsOut = (DSC_OUTPUT_PARAMS *)DSC_Malloc(sizeof(DSC_OUTPUT_PARAMS));
-    if (pPpsOut == NULL)
-    {
-        DSC_Print("ERROR - Memory allocation error.");
-        ret = NVT_STATUS_NO_MEMORY;
-        goto done;
-    }
 
     NVMISC_MEMSET(pPpsOut, 0, sizeof(DSC_OUTPUT_PARAMS));
     ret = DSC_PpsCalc(in, pPpsOut);
     if (ret != NVT_STATUS_SUCCESS)
     {
         DSC_Print("ERROR - Invalid parameter.");
-        goto done;
+        return ret;
     }
 
     DSC_PpsConstruct(pPpsOut, out);
 
-    /* fall through */
-done:
-    DSC_Free(pPpsOut);
-
     return ret;
 }
 
@@ -1713,60 +1620,44 @@ _validateInput
     return NVT_STATUS_SUCCESS;
 }
 
-/* ------------------------ Public Functions ------------------------------- */
-
 /*
- * @brief Calculate PPS parameters based on passed down Sink,
- *        GPU capability and modeset info
+ * @brief Validate the caller's parameters and fill in the PPS calculation input
+ *        for them. in->bits_per_pixel is set to the highest value allowed by the
+ *        available bandwidth and the sink.
  *
  * @param[in]   pDscInfo       Includes Sink and GPU DSC capabilities
  * @param[in]   pModesetInfo   Modeset related information
  * @param[in]   pWARData       Data required for providing WAR for issues
  * @param[in]   availableBandwidthBitsPerSecond      Available bandwidth for video
  *                                                   transmission(After FEC/Downspread overhead consideration)
- * @param[out]  pps                 Calculated PPS parameter.
- *                                  The data can be send to SetDscPpsData* methods directly.
- * @param[out]  pBitsPerPixelX16    Bits per pixel multiplied by 16
+ * @param[out]  in             PPS calculation input
  *
  * @returns NVT_STATUS_SUCCESS if successful;
- *          NVT_STATUS_ERR if unsuccessful;
- *          In case this returns failure consider that PPS is not possible.
+ *          NVT_STATUS_INVALID_PARAMETER if the parameters are invalid
  */
-NVT_STATUS
-DSC_GeneratePPS
+static NVT_STATUS
+_setupInputParams
 (
     const DSC_INFO *pDscInfo,
     const MODESET_INFO *pModesetInfo,
     const WAR_DATA *pWARData,
     NvU64 availableBandwidthBitsPerSecond,
-    NvU32 pps[DSC_MAX_PPS_SIZE_DWORD],
-    NvU32 *pBitsPerPixelX16
+    DSC_INPUT_PARAMS *in
 )
 {
-    DSC_INPUT_PARAMS *in = NULL;
-    NVT_STATUS ret = NVT_STATUS_ERR;
+    NVT_STATUS ret;
 
-    if ((!pDscInfo) || (!pModesetInfo) || (!pBitsPerPixelX16))
+    if ((!pDscInfo) || (!pModesetInfo))
     {
         DSC_Print("ERROR - Invalid parameter.");
-        ret = NVT_STATUS_INVALID_PARAMETER;
-        goto done;
+        return NVT_STATUS_INVALID_PARAMETER;
     }
 
     ret = _validateInput(pDscInfo, pModesetInfo, pWARData, availableBandwidthBitsPerSecond);
     if (ret != NVT_STATUS_SUCCESS)
     {
         DSC_Print("ERROR - Invalid parameter.");
-        ret = NVT_STATUS_INVALID_PARAMETER;
-        goto done;
-    }
-
-    in = (DSC_INPUT_PARAMS *)DSC_Malloc(sizeof(DSC_INPUT_PARAMS));
-    if (in == NULL)
-    {
-        DSC_Print("ERROR - Memory allocation error.");
-        ret = NVT_STATUS_NO_MEMORY;
-        goto done;
+        return NVT_STATUS_INVALID_PARAMETER;
     }
 
     NVMISC_MEMSET(in, 0, sizeof(DSC_INPUT_PARAMS));
@@ -1799,8 +1690,7 @@ DSC_GeneratePPS
         else
         {
             DSC_Print("ERROR - YCbCr422 is not possible with current config.");
-            ret = NVT_STATUS_INVALID_PARAMETER;
-            goto done;
+            return NVT_STATUS_INVALID_PARAMETER;
         }
         break;
     case NVT_COLOR_FORMAT_YCbCr420:
@@ -1814,15 +1704,13 @@ DSC_GeneratePPS
         else
         {
             DSC_Print("ERROR - YCbCr420 is not possible with current config.");
-            ret = NVT_STATUS_INVALID_PARAMETER;
-            goto done;
+            return NVT_STATUS_INVALID_PARAMETER;
         }
         break;
 
     default:
         DSC_Print("ERROR - Invalid color Format specified.");
-        ret = NVT_STATUS_INVALID_PARAMETER;
-        goto done;
+        return NVT_STATUS_INVALID_PARAMETER;
     }
 
     // calculate max possible bits per pixel allowed by the available bandwidth
@@ -1915,6 +1803,48 @@ DSC_GeneratePPS
 
     in->bits_per_pixel =  DSC_AlignDownForBppPrecision(in->bits_per_pixel, pDscInfo->sinkCaps.bitsPerPixelPrecision);
 
+    in->dsc_version_minor = pDscInfo->forcedDscParams.dscRevision.versionMinor ? pDscInfo->forcedDscParams.dscRevision.versionMinor :
+                            pDscInfo->sinkCaps.algorithmRevision.versionMinor;
+    in->pic_width = pModesetInfo->activeWidth;
+    in->pic_height = pModesetInfo->activeHeight;
+    in->slice_height = pDscInfo->forcedDscParams.sliceHeight;
+    in->slice_width = pDscInfo->forcedDscParams.sliceWidth;
+    in->slice_num = pDscInfo->forcedDscParams.sliceCount;
+    in->max_slice_num = MIN(pDscInfo->sinkCaps.maxNumHztSlices,
+                        pModesetInfo->bDualMode ? pDscInfo->gpuCaps.maxNumHztSlices * 2 : pDscInfo->gpuCaps.maxNumHztSlices);
+    in->max_slice_width = pDscInfo->sinkCaps.maxSliceWidth;
+    in->pixel_clkMHz = (NvU32)(pModesetInfo->pixelClockHz / 1000000L);
+    in->dual_mode = pModesetInfo->bDualMode;
+    in->drop_mode = pModesetInfo->bDropMode;
+    in->slice_count_mask = pDscInfo->sinkCaps.sliceCountSupportedMask;
+    in->peak_throughput_mode0 = pDscInfo->sinkCaps.peakThroughputMode0;
+    in->peak_throughput_mode1 = pDscInfo->sinkCaps.peakThroughputMode1;
+
+    return NVT_STATUS_SUCCESS;
+}
+
+/*
+ * @brief Pick the bits per pixel to generate the PPS for: the caller's value
+ *        if it is usable, or the optimal one otherwise.
+ *
+ * @param[in]      pDscInfo           Includes Sink and GPU DSC capabilities
+ * @param[in]      pModesetInfo       Modeset related information
+ * @param[in,out]  in                 PPS calculation input; bits_per_pixel holds
+ *                                    the highest allowed value on input
+ * @param[in,out]  pBitsPerPixelX16   Bits per pixel requested by the caller, or 0
+ *
+ * @returns NVT_STATUS_SUCCESS if successful;
+ *          NVT_STATUS_INVALID_PARAMETER if the requested value can't be used
+ */
+static NVT_STATUS
+_selectBitsPerPixel
+(
+    const DSC_INFO *pDscInfo,
+    const MODESET_INFO *pModesetInfo,
+    DSC_INPUT_PARAMS *in,
+    NvU32 *pBitsPerPixelX16
+)
+{
     // If user specified bits_per_pixel value to be used check if it is valid one
     if (*pBitsPerPixelX16 != 0)
     {
@@ -1922,8 +1852,7 @@ DSC_GeneratePPS
         if (*pBitsPerPixelX16 > in->bits_per_pixel)
         {
             DSC_Print("ERROR - Invalid bits per pixel value specified.");
-            ret = NVT_STATUS_INVALID_PARAMETER;
-            goto done;
+            return NVT_STATUS_INVALID_PARAMETER;
         }
         else
         {
@@ -1934,15 +1863,13 @@ DSC_GeneratePPS
         if (pModesetInfo->bDualMode && (in->bits_per_pixel > 256 /*bits_per_pixel = 16*/))
         {
             DSC_Print("ERROR - DSC Dual Mode, because of architectural limitation we can't use bits_per_pixel more than 16.");
-            ret = NVT_STATUS_INVALID_PARAMETER;
-            goto done;
+            return NVT_STATUS_INVALID_PARAMETER;
         }
 
         if ((pDscInfo->sinkCaps.maxBitsPerPixelX16 != 0) && (*pBitsPerPixelX16 > pDscInfo->sinkCaps.maxBitsPerPixelX16))
         {
             DSC_Print("ERROR - bits per pixel value specified by user is greater than what DSC decompressor can support.");
-            ret = NVT_STATUS_INVALID_PARAMETER;
-            goto done;
+            return NVT_STATUS_INVALID_PARAMETER;
         }
     }
     else
@@ -1972,34 +1899,185 @@ DSC_GeneratePPS
         }
     }
 
-    in->dsc_version_minor = pDscInfo->forcedDscParams.dscRevision.versionMinor ? pDscInfo->forcedDscParams.dscRevision.versionMinor :
-                            pDscInfo->sinkCaps.algorithmRevision.versionMinor;
-    in->pic_width = pModesetInfo->activeWidth;
-    in->pic_height = pModesetInfo->activeHeight;
-    in->slice_height = pDscInfo->forcedDscParams.sliceHeight;
-    in->slice_width = pDscInfo->forcedDscParams.sliceWidth;
-    in->slice_num = pDscInfo->forcedDscParams.sliceCount;
-    in->max_slice_num = MIN(pDscInfo->sinkCaps.maxNumHztSlices,
-                        pModesetInfo->bDualMode ? pDscInfo->gpuCaps.maxNumHztSlices * 2 : pDscInfo->gpuCaps.maxNumHztSlices);
-    in->max_slice_width = pDscInfo->sinkCaps.maxSliceWidth;
-    in->pixel_clkMHz = (NvU32)(pModesetInfo->pixelClockHz / 1000000L);
-    in->dual_mode = pModesetInfo->bDualMode;
-    in->drop_mode = pModesetInfo->bDropMode;
-    in->slice_count_mask = pDscInfo->sinkCaps.sliceCountSupportedMask;
-    in->peak_throughput_mode0 = pDscInfo->sinkCaps.peakThroughputMode0;
-    in->peak_throughput_mode1 = pDscInfo->sinkCaps.peakThroughputMode1;
+    return NVT_STATUS_SUCCESS;
+}
 
-    ret = DSC_PpsDataGen(in, pps);
+/* ------------------------ Public Functions ------------------------------- */
 
-    *pBitsPerPixelX16 = in->bits_per_pixel;
+/*
+ * @brief Calculate PPS parameters based on passed down Sink,
+ *        GPU capability and modeset info
+ *
+ * @param[in]   pDscInfo       Includes Sink and GPU DSC capabilities
+ * @param[in]   pModesetInfo   Modeset related information
+ * @param[in]   pWARData       Data required for providing WAR for issues
+ * @param[in]   availableBandwidthBitsPerSecond      Available bandwidth for video
+ *                                                   transmission(After FEC/Downspread overhead consideration)
+ * @param[out]  pps                 Calculated PPS parameter.
+ *                                  The data can be send to SetDscPpsData* methods directly.
+ * @param[out]  pBitsPerPixelX16    Bits per pixel multiplied by 16
+ *
+ * @returns NVT_STATUS_SUCCESS if successful;
+ *          NVT_STATUS_ERR if unsuccessful;
+ *          In case this returns failure consider that PPS is not possible.
+ */
+NVT_STATUS
+DSC_GeneratePPS
+(
+    const DSC_INFO *pDscInfo,
+    const MODESET_INFO *pModesetInfo,
+    const WAR_DATA *pWARData,
+    NvU64 availableBandwidthBitsPerSecond,
+    NvU32 pps[DSC_MAX_PPS_SIZE_DWORD],
+    NvU32 *pBitsPerPixelX16
+)
+{
+    DSC_GENERATE_PPS_WORKSPACE *pWorkspace;
+    NVT_STATUS ret;
+
+    pWorkspace = (DSC_GENERATE_PPS_WORKSPACE *)DSC_Malloc(sizeof(DSC_GENERATE_PPS_WORKSPACE));
+    if (pWorkspace == NULL)
+    {
+        DSC_Print("ERROR - Memory allocation error.");
+        return NVT_STATUS_NO_MEMORY;
+    }
+
+    ret = DSC_GeneratePPSWithWorkspace(pDscInfo, pModesetInfo, pWARData,
+                                       availableBandwidthBitsPerSecond,
+                                       pps, pBitsPerPixelX16, pWorkspace);
+
+    DSC_Free(pWorkspace);
+
+    return ret;
+}
+
+/*
+ * @brief Same as DSC_GeneratePPS, but uses caller supplied scratch memory
+ *        instead of allocating it
+ *
+ * @param[in]   pWorkspace     Scratch memory; contents are undefined on return
+ *
+ * See DSC_GeneratePPS for the other parameters and return values.
+ */
+NVT_STATUS
+DSC_GeneratePPSWithWorkspace
+(
+    const DSC_INFO *pDscInfo,
+    const MODESET_INFO *pModesetInfo,
+    const WAR_DATA *pWARData,
+    NvU64 availableBandwidthBitsPerSecond,
+    NvU32 pps[DSC_MAX_PPS_SIZE_DWORD],
+    NvU32 *pBitsPerPixelX16,
+    DSC_GENERATE_PPS_WORKSPACE *pWorkspace
+)
+{
+    DSC_INPUT_PARAMS *in;
+    NVT_STATUS ret;
+
+    if ((!pBitsPerPixelX16) || (!pWorkspace))
+    {
+        DSC_Print("ERROR - Invalid parameter.");
+        return NVT_STATUS_INVALID_PARAMETER;
+    }
+
+    in = &pWorkspace->in;
+
+    ret = _setupInputParams(pDscInfo, pModesetInfo, pWARData,
+                            availableBandwidthBitsPerSecond, in);
+    if (ret != NVT_STATUS_SUCCESS)
+    {
+        return ret;
+    }
 
-    /* fall through */
-done:
-    DSC_Free(in);
+    ret = _selectBitsPerPixel(pDscInfo, pModesetInfo, in, pBitsPerPixelX16);
+    if (ret != NVT_STATUS_SUCCESS)
+    {
+        return ret;
+    }
+
+    ret = DSC_PpsDataGen(in, &pWorkspace->out, pps);
+
+    *pBitsPerPixelX16 = in->bits_per_pixel;
 
     return ret;
 }
 
+/*
+ * @brief Calculate PPS parameters for several (slice count, bits per pixel)
+ *        candidates of the same mode. Input validation and the bandwidth
+ *        derived bits per pixel limit are computed once for all candidates.
+ *
+ * @param[in]     pDscInfo       Includes Sink and GPU DSC capabilities
+ * @param[in]     pModesetInfo   Modeset related information
+ * @param[in]     pWARData       Data required for providing WAR for issues
+ * @param[in]     availableBandwidthBitsPerSecond      Available bandwidth for video
+ *                                                     transmission(After FEC/Downspread overhead consideration)
+ * @param[in,out] pEntries       Candidates; see DSC_PPS_BATCH_ENTRY
+ * @param[in]     numEntries     Number of entries in pEntries
+ * @param[in]     pWorkspace     Scratch memory; contents are undefined on return
+ *
+ * @returns NVT_STATUS_SUCCESS if the candidates were evaluated; the result of
+ *          each candidate is in its status field.
+ *          An error if the mode itself is invalid, in which case no candidate
+ *          was evaluated.
+ */
+NVT_STATUS
+DSC_GeneratePPSBatch
+(
+    const DSC_INFO *pDscInfo,
+    const MODESET_INFO *pModesetInfo,
+    const WAR_DATA *pWARData,
+    NvU64 availableBandwidthBitsPerSecond,
+    DSC_PPS_BATCH_ENTRY *pEntries,
+    NvU32 numEntries,
+    DSC_GENERATE_PPS_WORKSPACE *pWorkspace
+)
+{
+    DSC_INPUT_PARAMS *in;
+    NvU32 maxBitsPerPixel;
+    NvU32 i;
+    NVT_STATUS ret;
+
+    if ((!pEntries && numEntries) || (!pWorkspace))
+    {
+        DSC_Print("ERROR - Invalid parameter.");
+        return NVT_STATUS_INVALID_PARAMETER;
+    }
+
+    in = &pWorkspace->in;
+
+    ret = _setupInputParams(pDscInfo, pModesetInfo, pWARData,
+                            availableBandwidthBitsPerSecond, in);
+    if (ret != NVT_STATUS_SUCCESS)
+    {
+        return ret;
+    }
+
+    maxBitsPerPixel = in->bits_per_pixel;
+
+    for (i = 0; i < numEntries; i++)
+    {
+        DSC_PPS_BATCH_ENTRY *pEntry = &pEntries[i];
+
+        in->bits_per_pixel = maxBitsPerPixel;
+        in->slice_num = pEntry->sliceCount ? pEntry->sliceCount :
+                        pDscInfo->forcedDscParams.sliceCount;
+
+        pEntry->status = _selectBitsPerPixel(pDscInfo, pModesetInfo, in,
+                                             &pEntry->bitsPerPixelX16);
+        if (pEntry->status != NVT_STATUS_SUCCESS)
+        {
+            continue;
+        }
+
+        pEntry->status = DSC_PpsDataGen(in, &pWorkspace->out, pEntry->pps);
+
+        pEntry->bitsPerPixelX16 = in->bits_per_pixel;
+    }
+
+    return NVT_STATUS_SUCCESS;
+}
+
 /*
  * @brief Initializes callbacks for print and assert
  *
@@ -40,6 +40,7 @@
 
 /* ------------------------ Macros ----------------------------------------- */
 #define DSC_MAX_PPS_SIZE_DWORD 32
+#define DSC_NUM_BUF_RANGES     15
 
 /* ------------------------ Datatypes -------------------------------------- */
 
@@ -271,6 +272,110 @@ typedef struct
     }dpData;
 } WAR_DATA;
 
+//input parameters to the pps calculation
+typedef struct
+{
+    NvU32  dsc_version_minor;     // DSC minor version (1-DSC1.1, 2-DSC 1.2)
+    NvU32  bits_per_component;    // bits per component of input pixels (8,10,12)
+    NvU32  linebuf_depth;         // bits per component of reconstructed line buffer (8 ~ 13)
+    NvU32  block_pred_enable;     // block prediction enable (0, 1)
+    NvU32  convert_rgb;           // input pixel format (0 YCbCr, 1 RGB)
+    NvU32  bits_per_pixel;        // bits per pixel*BPP_UNIT (8.0*BPP_UNIT ~ 32.0*BPP_UNIT)
+    NvU32  pic_height;            // picture height (8 ~ 8192)
+    NvU32  pic_width;             // picture width  (single mode: 32 ~ 5120, dual mode: 64 ~ 8192)
+    NvU32  slice_height;          // 0 - auto,   others (8 ~ 8192)  - must be (pic_height % slice_height == 0)
+    NvU32  slice_width;           // maximum slice_width, 0-- default: 1280.
+    NvU32  slice_num;             // 0 - auto,   others: 1,2,4,8
+    NvU32  slice_count_mask;      // no of slices supported by sink
+    NvU32  max_slice_num;         // slice number cap determined from GPU and sink caps
+    NvU32  max_slice_width;       // slice width cap determined from GPU and sink caps
+    NvU32  pixel_clkMHz;          // pixel clock frequency in MHz, used for slice_width calculation.
+    NvU32  dual_mode;             // 0 - single mode, 1 - dual mode, only for checking pic_width
+    NvU32  simple_422;            // 4:2:2 simple mode
+    NvU32  native_420;            // 420 native mode
+    NvU32  native_422;            // 422 native mode
+    NvU32  drop_mode;             // 0 - normal mode, 1 - drop mode.
+    NvU32  peak_throughput_mode0; // peak throughput supported by the sink for 444 and simple 422 modes. 
+    NvU32  peak_throughput_mode1; // peak throughput supported by the sink for native 422 and 420 modes.
+} DSC_INPUT_PARAMS;
+
+//output pps parameters after calculation
+typedef struct
+{
+    NvU32  dsc_version_major;                // DSC major version, always 1
+    NvU32  dsc_version_minor;                // DSC minor version
+    NvU32  pps_identifier;                   // Application-specific identifier, always 0
+    NvU32  bits_per_component;               // bits per component for input pixels
+    NvU32  linebuf_depth;                    // line buffer bit depth
+    NvU32  block_pred_enable;                // enable/disable block prediction
+    NvU32  convert_rgb;                      // color space for input pixels
+    NvU32  simple_422;                       // 4:2:2 simple mode
+    NvU32  vbr_enable;                       // enable VBR mode
+    NvU32  bits_per_pixel;                   // (bits per pixel * BPP_UNIT) after compression
+    NvU32  pic_height;                       // picture height
+    NvU32  pic_width;                        // picture width
+    NvU32  slice_height;                     // slice height
+    NvU32  slice_width;                      // slice width
+    NvU32  chunk_size;                       // the size in bytes of the slice chunks
+    NvU32  initial_xmit_delay;               // initial transmission delay
+    NvU32  initial_dec_delay;                // initial decoding delay
+    NvU32  initial_scale_value;              // initial xcXformScale factor value
+    NvU32  scale_increment_interval;         // number of group times between incrementing the rcXformScale factor
+    NvU32  scale_decrement_interval;         // number of group times between decrementing the rcXformScale factor
+    NvU32  first_line_bpg_offset;            // number of additional bits allocated for each group on the first line in a slice
+    NvU32  nfl_bpg_offset;                   // number of bits de-allocated for each group after the first line in a slice
+    NvU32  slice_bpg_offset;                 // number of bits de-allocated for each group to enforce the slice constrain
+    NvU32  initial_offset;                   // initial value for rcXformOffset
+    NvU32  final_offset;                     // maximum end-of-slice value for rcXformOffset
+    NvU32  flatness_min_qp;                  // minimum flatness QP
+    NvU32  flatness_max_qp;                  // maximum flatness QP
+    //rc_parameter_set
+    NvU32  rc_model_size;                    // number of bits within the "RC model"
+    NvU32  rc_edge_factor;                   // edge detection factor
+    NvU32  rc_quant_incr_limit0;             // QP threshold for short-term RC
+    NvU32  rc_quant_incr_limit1;             // QP threshold for short-term RC
+    NvU32  rc_tgt_offset_hi;                 // upper end of the target bpg range for short-term RC
+    NvU32  rc_tgt_offset_lo;                 // lower end of the target bpg range for short-term RC
+    NvU32  rc_buf_thresh[DSC_NUM_BUF_RANGES-1];  // thresholds in "RC model"
+    //rc_range_parameters
+    NvU32  range_min_qp[DSC_NUM_BUF_RANGES];     // minimum QP for each of the RC ranges
+    NvU32  range_max_qp[DSC_NUM_BUF_RANGES];     // maximum QP for each of the RC ranges
+    NvU32  range_bpg_offset[DSC_NUM_BUF_RANGES]; // bpg adjustment for each of the RC ranges
+    //420,422
+    NvU32  native_420;                       // 420 native mode
+    NvU32  native_422;                       // 422 native mode
+    NvU32  second_line_bpg_offset;           // 2nd line bpg offset to use, native 420 only
+    NvU32  nsl_bpg_offset;                   // non-2nd line bpg offset to use, native 420 only
+    NvU32  second_line_offset_adj;           // adjustment to 2nd line bpg offset, native 420 only
+
+    //additional params not in PPS
+    NvU32 slice_num;
+    NvU32 groups_per_line;
+    NvU32 num_extra_mux_bits;
+    NvU32 flatness_det_thresh;
+} DSC_OUTPUT_PARAMS;
+
+//
+// Scratch memory for the PPS calculation. DSC_GeneratePPS() allocates one per call;
+// callers validating many modes can keep one (on the stack or in a long-lived object)
+// and use DSC_GeneratePPSWithWorkspace() or DSC_GeneratePPSBatch() instead.
+//
+typedef struct
+{
+    DSC_INPUT_PARAMS  in;
+    DSC_OUTPUT_PARAMS out;
+} DSC_GENERATE_PPS_WORKSPACE;
+
+// One (slice count, bits per pixel) candidate for DSC_GeneratePPSBatch()
+typedef struct
+{
+    NvU32      sliceCount;                   // [in]  0 to use DSC_INFO::forcedDscParams.sliceCount
+    NvU32      bitsPerPixelX16;              // [in]  0 to pick the optimal value
+                                             // [out] bits per pixel the PPS was generated for
+    NVT_STATUS status;                       // [out] result for this candidate
+    NvU32      pps[DSC_MAX_PPS_SIZE_DWORD];  // [out] PPS, valid if status is NVT_STATUS_SUCCESS
+} DSC_PPS_BATCH_ENTRY;
+
 /*
  *  Windows testbed compiles are done with warnings as errors
  *  with the maximum warning level.  Here we turn off some
@@ -321,6 +426,49 @@ NVT_STATUS DSC_GeneratePPS(const DSC_INFO *pDscInfo,
                            NvU32 pps[DSC_MAX_PPS_SIZE_DWORD],
                            NvU32 *pBitsPerPixelX16);
 
+/*
+ * @brief Same as DSC_GeneratePPS, but uses caller supplied scratch memory
+ *        instead of allocating it
+ *
+ * @param[in]   pWorkspace     Scratch memory; contents are undefined on return
+ *
+ * See DSC_GeneratePPS for the other parameters and return values.
+ */
+NVT_STATUS DSC_GeneratePPSWithWorkspace(const DSC_INFO *pDscInfo,
+                                        const MODESET_INFO *pModesetInfo,
+                                        const WAR_DATA *pWARData,
+                                        NvU64 availableBandwidthBitsPerSecond,
+                                        NvU32 pps[DSC_MAX_PPS_SIZE_DWORD],
+                                        NvU32 *pBitsPerPixelX16,
+                                        DSC_GENERATE_PPS_WORKSPACE *pWorkspace);
+
+/*
+ * @brief Calculate PPS parameters for several (slice count, bits per pixel)
+ *        candidates of the same mode. Input validation and the bandwidth
+ *        derived bits per pixel limit are computed once for all candidates.
+ *
+ * @param[in]     pDscInfo       Includes Sink and GPU DSC capabilities
+ * @param[in]     pModesetInfo   Modeset related information
+ * @param[in]     pWARData       Data required for providing WAR for issues
+ * @param[in]     availableBandwidthBitsPerSecond      Available bandwidth for video
+ *                                                     transmission(After FEC/Downspread overhead consideration)
+ * @param[in,out] pEntries       Candidates; see DSC_PPS_BATCH_ENTRY
+ * @param[in]     numEntries     Number of entries in pEntries
+ * @param[in]     pWorkspace     Scratch memory; contents are undefined on return
+ *
+ * @returns NVT_STATUS_SUCCESS if the candidates were evaluated; the result of
+ *          each candidate is in its status field.
+ *          An error if the mode itself is invalid, in which case no candidate
+ *          was evaluated.
+ */
+NVT_STATUS DSC_GeneratePPSBatch(const DSC_INFO *pDscInfo,
+                                const MODESET_INFO *pModesetInfo,
+                                const WAR_DATA *pWARData,
+                                NvU64 availableBandwidthBitsPerSecond,
+                                DSC_PPS_BATCH_ENTRY *pEntries,
+                                NvU32 numEntries,
+                                DSC_GENERATE_PPS_WORKSPACE *pWorkspace);
+
 #ifdef __cplusplus
 }
 #endif
@@ -2250,6 +2250,27 @@ typedef struct
     NvV32    status;
 } NVOS54_PARAMETERS;
 
+/* Batched RM Control
+ *
+ * Executes several RM Controls against one client with a single API lock
+ * acquisition.  Input layout for user space batched calls should be:
+ *
+ * +--- NVOS54_BATCH_PARAMETERS ---+--- NVOS54_PARAMETERS[numEntries] ---+
+ *
+ * Each entry's hClient must match NVOS54_BATCH_PARAMETERS::hClient and its
+ * flags must be NVOS54_FLAGS_NONE.  Entries are executed in order and each
+ * one reports its own status; a failing entry does not stop the batch.
+ */
+#define NVOS54_BATCH_MAX_ENTRIES                                   (256)
+
+typedef struct
+{
+    NvHandle hClient;       // [IN]  client handle shared by all entries
+    NvU32    numEntries;    // [IN]  number of NVOS54_PARAMETERS that follow
+    NvV32    status;        // [OUT] status of the batch as a whole
+    NvU32    reserved;      // [IN]  must be zero
+} NVOS54_BATCH_PARAMETERS;
+
 /* RM Control header
  *
  * Replacement for NVOS54_PARAMETERS where embedded pointers are not allowed.
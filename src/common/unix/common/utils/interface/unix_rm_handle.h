@@ -31,7 +31,7 @@ extern "C" {
 #include "nvtypes.h"
 
 #define NV_UNIX_RM_HANDLE_INITIAL_HANDLES  512
-#define NV_UNIX_RM_HANDLE_BITMAP_SIZE(_numHandles)  ((_numHandles) >> 5)
+#define NV_UNIX_RM_HANDLE_BITMAP_SIZE(_numHandles)  ((_numHandles) >> 6)
 
 #if defined(DEBUG)
 typedef struct _nv_unix_rm_handle_allocation *NVUnixRmHandleAllocationPtr;
@@ -48,9 +48,12 @@ typedef struct _nv_unix_rm_handle_allocator {
     NvU32 rmClient;
     NvU32 clientData;
 
-    NvU32 *bitmap;
+    NvU64 *bitmap;
     NvU32 maxHandles;
 
+    /* Bitmap word where the search for the next free handle starts */
+    NvU32 nextFreeWord;
+
 #if defined(DEBUG)
     NVUnixRmHandleAllocationRec *allocationTable;
 #endif
@@ -30,7 +30,10 @@
  * replayed during channel recovery, the handle value must be kept
  * constant.  For such handles, use an invariant handle value.
  *
- * We keep a bitmap of which handles we've used.
+ * We keep a bitmap of which handles we've used.  Allocation scans the
+ * bitmap a 64-bit word at a time, starting from the word where the
+ * previous allocation found a free handle, so that allocating handles
+ * does not rescan the used handles at the start of the bitmap.
  *
  * Composition of an object handle:
  * [31:16]  Client data
@@ -40,6 +43,7 @@
 #include <stddef.h>
 
 #include "unix_rm_handle.h"
+#include "nvmisc.h"
 
 #define INVALID_HANDLE 0
 #define UNIX_RM_HANDLE_CLIENT_DATA_SHIFT         16
@@ -55,18 +59,18 @@
 #define GET_CLIENT_DATA_BITS(_data) \
     (((_data) << UNIX_RM_HANDLE_CLIENT_DATA_SHIFT))
 
-#define DWORD_FROM_HANDLE(_handle) (HANDLE_INDEX(_handle) >> 5)
-#define BIT_FROM_HANDLE(_handle) (HANDLE_INDEX(_handle) & 0x1f)
+#define QWORD_FROM_HANDLE(_handle) (HANDLE_INDEX(_handle) >> 6)
+#define BIT_FROM_HANDLE(_handle) (HANDLE_INDEX(_handle) & 0x3f)
 
 /* Check if a handle is used */
 #define USED(_bitmap, _handle) \
-    ((_bitmap)[DWORD_FROM_HANDLE(_handle)] & (1U << BIT_FROM_HANDLE(_handle)))
+    ((_bitmap)[QWORD_FROM_HANDLE(_handle)] & NVBIT64(BIT_FROM_HANDLE(_handle)))
 /* Reserve a handle in the bitmap */
 #define RESERVE(_bitmap, _handle) \
-    ((_bitmap)[DWORD_FROM_HANDLE(_handle)] |= (1U << BIT_FROM_HANDLE(_handle)))
+    ((_bitmap)[QWORD_FROM_HANDLE(_handle)] |= NVBIT64(BIT_FROM_HANDLE(_handle)))
 /* Unreserve a handle in the bitmap */
 #define UNRESERVE(_bitmap, _handle) \
-    ((_bitmap)[DWORD_FROM_HANDLE(_handle)] &= (~(1U << BIT_FROM_HANDLE(_handle))))
+    ((_bitmap)[QWORD_FROM_HANDLE(_handle)] &= (~NVBIT64(BIT_FROM_HANDLE(_handle))))
 
 #if defined(DEBUG)
 static void
@@ -87,7 +91,7 @@ static void UnixRmHandleMemset(void *ptr, char data, NvLength size)
 static NvBool UnixRmHandleReallocBitmap(NVUnixRmHandleAllocatorPtr pAllocator,
                                         NvU32 newMaxHandles)
 {
-    NvU32 *newBitmap;
+    NvU64 *newBitmap;
 #if defined(DEBUG)
     NVUnixRmHandleAllocationPtr newAllocationTable;
 #endif /* defined(DEBUG) */
@@ -104,7 +108,7 @@ static NvBool UnixRmHandleReallocBitmap(NVUnixRmHandleAllocatorPtr pAllocator,
     /* New handle limit must be a power of 2 */
     nvUnixRmHandleAssert(!(newMaxHandles & (newMaxHandles - 1)));
 
-    newBitmap = (NvU32 *)nvUnixRmHandleReallocMem(pAllocator->bitmap, newMemSize);
+    newBitmap = (NvU64 *)nvUnixRmHandleReallocMem(pAllocator->bitmap, newMemSize);
 
     if (!newBitmap) {
         return NV_FALSE;
@@ -179,6 +183,33 @@ NvBool nvInitUnixRmHandleAllocator(NVUnixRmHandleAllocatorPtr pAllocator,
     return NV_TRUE;
 }
 
+/*
+ * Find a free handle ID, scanning the bitmap one word at a time starting
+ * at pAllocator->nextFreeWord and wrapping around at the end.  Returns
+ * INVALID_HANDLE if every handle ID below maxHandles is in use.
+ */
+static NvU32 UnixRmHandleFindFree(NVUnixRmHandleAllocatorPtr pAllocator)
+{
+    const NvU32 numWords =
+        NV_UNIX_RM_HANDLE_BITMAP_SIZE(pAllocator->maxHandles);
+    NvU32 i;
+
+    /* maxHandles is a power of 2, so numWords is too */
+    nvUnixRmHandleAssert(!(numWords & (numWords - 1)));
+
+    for (i = 0; i < numWords; i++) {
+        const NvU32 word = (pAllocator->nextFreeWord + i) & (numWords - 1);
+        const NvU64 freeBits = ~pAllocator->bitmap[word];
+
+        if (freeBits != 0) {
+            pAllocator->nextFreeWord = word;
+            return (word << 6) + BIT_IDX_64(LOWESTBIT(freeBits)) + 1;
+        }
+    }
+
+    return INVALID_HANDLE;
+}
+
 /*
  * nvGenerateUnixRmHandleInternal()
  *   Return a unique, random handle. Be sure to free the handle
@@ -194,17 +225,19 @@ NvU32 nvGenerateUnixRmHandleInternal(NVUnixRmHandleAllocatorPtr pAllocator)
                          pAllocator->clientData != 0);
 
     /* Find free handle */
-    handleId = 1;
-    while (USED(pAllocator->bitmap, handleId) &&
-           (handleId <= pAllocator->maxHandles)) {
-        handleId++;
-    }
+    handleId = UnixRmHandleFindFree(pAllocator);
+
+    if (handleId == INVALID_HANDLE) {
+        const NvU32 oldMaxHandles = pAllocator->maxHandles;
 
-    if (handleId > pAllocator->maxHandles) {
         if (!UnixRmHandleReallocBitmap(pAllocator, pAllocator->maxHandles * 2)) {
             nvUnixRmHandleAssert(!"Failed to grow RM handle allocator bitmap");
             return INVALID_HANDLE;
         }
+
+        /* The first handle past the old limit is now free */
+        handleId = oldMaxHandles + 1;
+        pAllocator->nextFreeWord = QWORD_FROM_HANDLE(handleId);
     }
 
     nvUnixRmHandleAssert(!USED(pAllocator->bitmap, handleId));
@@ -37,6 +37,7 @@ NVDpyEvoPtr nvAllocDpyEvo(NVDispEvoPtr pDispEvo,
                           NVConnectorEvoPtr pConnectorEvo,
                           NVDpyId dpyId, const char *dpAddress);
 void nvFreeDpyEvo(NVDispEvoPtr pDispEvo, NVDpyEvoPtr pDpyEvo);
+void nvDpyFreeParsedEdidCache(NVDevEvoPtr pDevEvo);
 NVConnectorEvoPtr nvGetConnectorFromDisp(NVDispEvoPtr pDispEvo, NVDpyId dpyId);
 
 void nvUpdateInfoFrames(const NVDispEvoRec *pDispEvo, const NvU32 head);
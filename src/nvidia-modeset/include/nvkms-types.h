@@ -106,6 +106,9 @@ extern "C" {
 
 #define NVKMS_MAX_WINDOWS_PER_DISP          32
 
+/* Number of parsed EDIDs cached per device; each entry is ~32KB. */
+#define NV_PARSED_EDID_CACHE_SIZE           4
+
 #define NV_SYNCPT_GLOBAL_TABLE_LENGTH      1024
 
 #define HEAD_MASK_QUERY(_mask, _head) (!!((_mask) & (1 << (_head))))
@@ -160,9 +163,19 @@ typedef struct _nv_dplibtimer NVDPLibTimerRec, *NVDPLibTimerPtr;
 /* _NVEvoModesetUpdateState defined in nvkms-modeset-types.h */
 typedef struct _NVEvoModesetUpdateState NVEvoModesetUpdateState;
 
+typedef struct _NVEvoApiHandleSlotRec {
+    void *pointer; /* NULL if the slot is free. */
+    NvU32 livePos; /* Index in liveSlots; stale once the slot is freed. */
+    NvU32 nextFree; /* 1-based index of the next free slot, or 0. */
+} NVEvoApiHandleSlotRec;
+
 typedef struct _NVEvoApiHandlesRec {
-    void **pointers; /* Dynamically allocated array of pointers. */
-    NvU32 numPointers; /* Number of elements in pointers array. */
+    NVEvoApiHandleSlotRec *slots; /* Dynamically allocated array of slots. */
+    NvU32 *liveSlots; /* Dense array of the indices of the used slots. */
+    NvU32 numSlots; /* Number of elements in slots and liveSlots arrays. */
+    NvU32 numLive; /* Number of used slots. */
+    NvU32 freeHead; /* 1-based index of the first free slot, or 0. */
+    NvU32 shrinkNumLive; /* Try to shrink once numLive drops to this. */
     NvU32 defaultSize;
 } NVEvoApiHandlesRec;
 
@@ -472,6 +485,13 @@ typedef struct _NVEvoChannel {
     NVEvoChannelCaps caps;
 
     NVEvoSyncpt postSyncpt;
+
+    /* Waits for push buffer space in nvEvoMakeRoom(), reported in procfs. */
+    struct {
+        NvU32 count;
+        NvU64 totalUsec;
+        NvU64 maxUsec;
+    } stalls;
 } NVEvoChannel;
 
 typedef enum {
@@ -1032,6 +1052,25 @@ typedef struct _NVEvoDevRec {
      */
     struct nvkms_ref_ptr *ref_ptr;
 
+    /*
+     * Serializes device-local ioctls (see nvKmsIoctlIsDeviceLocal()), which
+     * run without the global nvkms_lock.  All other paths into core NVKMS
+     * exclude device-local ioctls globally and do not need to take this.
+     */
+    nvkms_sema_handle_t *pDeviceLock;
+
+    /*
+     * Recently parsed EDIDs, most recently used first, so that re-probing
+     * an unchanged display does not re-run the EDID parser.  Entries are
+     * allocated on demand; see PatchAndParseEdid().
+     */
+    struct {
+        struct _NVParsedEdidCacheEntryRec
+            *entries[NV_PARSED_EDID_CACHE_SIZE];
+        NvU32 hits;
+        NvU32 misses;
+    } parsedEdidCache;
+
     struct {
         void *handle;
     } hdmiLib;
@@ -1649,6 +1688,15 @@ typedef struct _NVParsedEdidEvoRec {
     char                 serialNumberString[NVT_EDID_LDD_PAYLOAD_SIZE+1];
 } NVParsedEdidEvoRec;
 
+typedef struct _NVParsedEdidCacheEntryRec {
+    /* The EDID bytes that were handed to the parser, and their CRC32. */
+    NvU32                crc32;
+    NvU8                *edidBuffer;
+    size_t               edidLength;
+
+    NVParsedEdidEvoRec   parsedEdid;
+} NVParsedEdidCacheEntryRec;
+
 typedef struct _NVDpyEvoRec {
     NVListRec dpyListEntry;
     NVDpyId  id;
@@ -2263,6 +2311,11 @@ typedef struct {
 
 #if defined(DEBUG)
     NVListRec debugMemoryAllocationList;
+    /*
+     * Protects debugMemoryAllocationList: device-local paths on different
+     * devices may allocate concurrently.  NULL before nvKmsModuleLoad().
+     */
+    nvkms_sema_handle_t *debugMemoryAllocationLock;
 #endif
 
     struct NvKmsPerOpen *nvKmsPerOpen;
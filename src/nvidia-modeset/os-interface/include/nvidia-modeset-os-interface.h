@@ -264,7 +264,11 @@ nvkms_alloc_timer_with_ref_ptr(nvkms_timer_proc_t *proc,
  * yet been called, freeing the nvkms_timer_handle_t will guarantee
  * that it is not called.
  *
- * The nvkms_lock must be held when calling nvkms_free_timer().
+ * The nvkms_lock must be held when calling nvkms_free_timer(), or the
+ * caller must be a device-local ioctl (see nvKmsIoctlIsDeviceLocal()),
+ * which excludes nvkms_alloc_timer() callbacks.  A timer allocated with
+ * nvkms_alloc_device_timer() may also be freed while holding only its
+ * device_lock.
  */
 void nvkms_free_timer  (nvkms_timer_handle_t *handle);
 
@@ -348,6 +352,47 @@ void nvkms_sema_free     (nvkms_sema_handle_t *sema);
 void nvkms_sema_down     (nvkms_sema_handle_t *sema);
 void nvkms_sema_up       (nvkms_sema_handle_t *sema);
 
+/*!
+ * Schedule a callback function that only touches state owned by one device.
+ *
+ * This function is like nvkms_alloc_timer(), except that the callback is
+ * called with 'device_lock' held (see nvkms_sema_alloc()).  When core NVKMS
+ * allows it (see nvKmsTimerIsDeviceLocal()), the nvkms_lock is released
+ * before the callback runs, so that the callback does not stall ioctls and
+ * timers on other devices; otherwise the nvkms_lock is held as well.
+ *
+ * 'device_lock' must remain allocated until the timer has been freed with
+ * nvkms_free_timer() while holding the nvkms_lock.
+ */
+nvkms_timer_handle_t*
+nvkms_alloc_device_timer(nvkms_timer_proc_t *proc,
+                         void *dataPtr, NvU32 dataU32,
+                         NvU64 usec,
+                         nvkms_sema_handle_t *device_lock);
+
+/*!
+ * Return the device lock of the object a ref_ptr-based device timer refers
+ * to.  Called with the nvkms_lock held.
+ */
+typedef nvkms_sema_handle_t*
+nvkms_timer_device_lock_proc_t(void *dataPtr);
+
+/*!
+ * Schedule a callback function that only touches state owned by one device.
+ *
+ * This function is like nvkms_alloc_timer_with_ref_ptr(), except that the
+ * callback is called with the device lock returned by 'get_device_lock'
+ * held, and without the nvkms_lock when core NVKMS allows it, as described
+ * for nvkms_alloc_device_timer().  'get_device_lock' is only called if the
+ * object the ref_ptr refers to still exists.
+ */
+NvBool
+nvkms_alloc_device_timer_with_ref_ptr(nvkms_timer_proc_t *proc,
+                                      struct nvkms_ref_ptr *ref_ptr,
+                                      NvU32 dataU32, NvU64 usec,
+                                      nvkms_timer_device_lock_proc_t
+                                          *get_device_lock);
+
 /*!
  * APIs to register/unregister backlight device.
  */
@@ -58,6 +58,10 @@ NvBool nvKmsIoctl(
     NvU64 paramsAddress,
     const size_t paramSize);
 
+NvBool nvKmsIoctlIsDeviceLocal(void *pOpenVoid, NvU32 cmd);
+
+NvBool nvKmsTimerIsDeviceLocal(void);
+
 void nvKmsClose(void *pOpenVoid);
 
 void* nvKmsOpen(
@@ -82,7 +82,8 @@ static NVDpyEvoPtr FindMatchingDisconnectedDpy(NVDispEvoPtr pDispEvo,
     return NULL;
 }
 
-const char *nvDPGetDeviceGUIDStr(DisplayPort::Device *device)
+const char *nvDPGetDeviceGUIDStr(DisplayPort::Device *device,
+                                 DisplayPort::GUID::StringBuffer &sb)
 {
     DisplayPort::GUID guid;
 
@@ -92,7 +93,6 @@ const char *nvDPGetDeviceGUIDStr(DisplayPort::Device *device)
 
     guid = device->getGUID();
     if (!guid.isGuidZero()) {
-        static DisplayPort::GUID::StringBuffer sb;
         guid.toString(sb);
         return sb;
     }
@@ -121,7 +121,8 @@ bool nvDPGetDeviceGUID(DisplayPort::Device *device,
 
 
 static const char *DPGetDevicePortStr(DisplayPort::Device *device,
-                                      bool skipLeadingZero)
+                                      bool skipLeadingZero,
+                                      DisplayPort::Address::StringBuffer &sb)
 {
     DisplayPort::Address addr;
 
@@ -131,7 +132,6 @@ static const char *DPGetDevicePortStr(DisplayPort::Device *device,
 
     addr = device->getTopologyAddress();
     if (addr.size() > 0) {
-        static DisplayPort::Address::StringBuffer sb;
         addr.toString(sb, skipLeadingZero);
         return sb;
     }
@@ -148,6 +148,8 @@ static void nvDPPrintDeviceInfo(NVConnectorEvoPtr pConnectorEvo,
     const char *connectorType;
     unsigned major, minor;
     const char *tmp;
+    DisplayPort::Address::StringBuffer addrStr;
+    DisplayPort::GUID::StringBuffer guidStr;
 
     device->getDpcdRevision(&major, &minor);
 
@@ -177,12 +179,13 @@ static void nvDPPrintDeviceInfo(NVConnectorEvoPtr pConnectorEvo,
                  "%s-%d: new DisplayPort %d.%d device detected",
                  NvKmsConnectorTypeString(pConnectorEvo->type),
                  pConnectorEvo->typeIndex, major, minor);
-    tmp = DPGetDevicePortStr(device, false /* skipLeadingZero */);
+    tmp = DPGetDevicePortStr(device, false /* skipLeadingZero */,
+                             addrStr);
     if (tmp) {
         nvEvoLogDisp(pDispEvo, EVO_LOG_INFO,
                      "  Address:     %s", tmp);
     }
-    tmp = nvDPGetDeviceGUIDStr(device);
+    tmp = nvDPGetDeviceGUIDStr(device, guidStr);
     if (tmp) {
         nvEvoLogDisp(pDispEvo, EVO_LOG_INFO,
                      "  GUID:        {%s}", tmp);
@@ -258,11 +261,13 @@ void ConnectorEventSink::newDevice(DisplayPort::Device *device)
     pDpLibDevice->device = device;
 
     if (device->isMultistream()) {
+        DisplayPort::Address::StringBuffer addrStr;
+
         // Get a dynamic pDpy for this device based on its bus topology path.
         // This will create one if it doesn't exist.
         pDpyEvo = nvGetDPMSTDpyEvo(
             pConnectorEvo,
-            DPGetDevicePortStr(device, true /* skipLeadingZero */),
+            DPGetDevicePortStr(device, true /* skipLeadingZero */, addrStr),
             &dynamicDpyCreated);
 
     } else {
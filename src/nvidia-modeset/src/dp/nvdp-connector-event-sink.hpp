@@ -54,7 +54,8 @@ public:
     virtual void notifyMCCSEvent(DisplayPort::Device *dev);
 };
 
-const char *nvDPGetDeviceGUIDStr(DisplayPort::Device *device);
+const char *nvDPGetDeviceGUIDStr(DisplayPort::Device *device,
+                                 DisplayPort::GUID::StringBuffer &sb);
 bool nvDPGetDeviceGUID(DisplayPort::Device *device, NvU8 guid[DPCD_GUID_SIZE]);
 
 }; // namespace nvkmsDisplayPort
@@ -92,6 +92,7 @@ void nvDPGetDpyGUID(NVDpyEvoPtr pDpyEvo)
 {
     NVDPLibDevicePtr pDpLibDevice;
     const char *str;
+    DisplayPort::GUID::StringBuffer guidStr;
 
     nvkms_memset(&pDpyEvo->dp.guid, 0, sizeof(pDpyEvo->dp.guid));
 
@@ -113,7 +114,8 @@ void nvDPGetDpyGUID(NVDpyEvoPtr pDpyEvo)
         return;
     }
 
-    str = nvkmsDisplayPort::nvDPGetDeviceGUIDStr(pDpLibDevice->device);
+    str = nvkmsDisplayPort::nvDPGetDeviceGUIDStr(pDpLibDevice->device,
+                                                 guidStr);
     if (str != NULL) {
         nvkms_strncpy(pDpyEvo->dp.guid.str, str, sizeof(pDpyEvo->dp.guid.str));
     } else {
@@ -36,7 +36,8 @@ namespace nvkmsDisplayPort {
                               int ms)
         : dpCallback(dpCallback),
           ref_ptr(pDevEvo->ref_ptr),
-          handle(nvkms_alloc_timer(onTimerFired, this, 0, ms * 1000)),
+          handle(nvkms_alloc_device_timer(onTimerFired, this, 0, ms * 1000,
+                                          pDevEvo->pDeviceLock)),
           expireTimeUs(nvkms_get_usec() + ms * 1000)
     {
         if (!allocFailed()) {
@@ -33,6 +33,16 @@
 #define NV_DMA_PUSHER_CHASE_PAD 5
 #define NV_EVO_NOTIFIER_SHORT_TIMEOUT_USEC 3000000 // 3 seconds
 
+/*
+ * nvEvoMakeRoom() polls GET with nvkms_yield() in between for this long,
+ * and then sleeps for a fixed interval between polls.  The interval is the
+ * shortest nvkms_usleep() will actually sleep rather than busy-wait, and is
+ * kept well below a refresh period so that space freed at vblank is picked
+ * up within the same frame even at high refresh rates.
+ */
+#define NV_EVO_MAKE_ROOM_YIELD_USEC     1000 // 1 millisecond
+#define NV_EVO_MAKE_ROOM_SLEEP_USEC     1000 // 1 millisecond
+
 static void EvoCoreKickoff(NVDmaBufferEvoPtr push_buffer, NvU32 putOffset);
 
 void nvDmaKickoffEvo(NVEvoChannelPtr pChannel)
@@ -157,12 +167,25 @@ static NvU32 EvoReadGetOffset(NVDmaBufferEvoPtr push_buffer, NvBool minimum)
     return bestGet;
 }
 
+/*
+ * Account for one wait for push buffer space that started at stallStart.
+ */
+static void EvoRecordMakeRoomStall(NVEvoChannelPtr pChannel, NvU64 stallStart)
+{
+    const NvU64 stallUsec = nvkms_get_usec() - stallStart;
+
+    pChannel->stalls.count++;
+    pChannel->stalls.totalUsec += stallUsec;
+    pChannel->stalls.maxUsec = NV_MAX(pChannel->stalls.maxUsec, stallUsec);
+}
+
 void nvEvoMakeRoom(NVEvoChannelPtr pChannel, NvU32 count)
 {
     NVDmaBufferEvoPtr push_buffer = &pChannel->pb;
     NvU32 getOffset;
     NvU32 putOffset;
     NvU64 startTime = 0;
+    NvU64 stallStart = 0;
     const NvU64 timeout = 5000000; /* 5 seconds */
 
     putOffset = (NvU32) ((char *)push_buffer->buffer -
@@ -207,6 +230,9 @@ void nvEvoMakeRoom(NVEvoChannelPtr pChannel, NvU32 count)
                    ((getOffset - putOffset) >> 2) - 1;
         }
         if (push_buffer->fifo_free_count > count) {
+            if (stallStart != 0) {
+                EvoRecordMakeRoomStall(pChannel, stallStart);
+            }
             break;
         }
 
@@ -224,7 +250,21 @@ void nvEvoMakeRoom(NVEvoChannelPtr pChannel, NvU32 count)
             startTime = 0;
         }
 
-        nvkms_yield();
+        /*
+         * The GPU usually drains the push buffer quickly, so poll with
+         * nvkms_yield() at first.  If it does not, e.g. because it is
+         * waiting for a vblank, back off to sleeping rather than spinning
+         * on the CPU for the rest of the wait.
+         */
+        if (stallStart == 0) {
+            stallStart = nvkms_get_usec();
+        }
+
+        if ((nvkms_get_usec() - stallStart) < NV_EVO_MAKE_ROOM_YIELD_USEC) {
+            nvkms_yield();
+        } else {
+            nvkms_usleep(NV_EVO_MAKE_ROOM_SLEEP_USEC);
+        }
    }
 }
 
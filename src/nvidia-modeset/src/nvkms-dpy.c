@@ -1293,9 +1293,9 @@ static NvBool ValidateEdid(const NVDpyEvoRec *pDpyEvo, NVEdidPtr pEdid,
     return (status == 0);
 }
 
-static const char *GetColorDepthBpc(NVT_COLORDEPTH colorDepth)
+static const char *GetColorDepthBpc(NVT_COLORDEPTH colorDepth,
+                                    char *buffer, size_t bufferSize)
 {
-    static char buffer[32];
     NVEvoInfoStringRec infoString;
     NvBool first = TRUE;
     int i;
@@ -1312,7 +1312,7 @@ static const char *GetColorDepthBpc(NVT_COLORDEPTH colorDepth)
         { colorDepth.bpc.bpc16, 16 },
     };
 
-    nvInitInfoString(&infoString, buffer, sizeof(buffer));
+    nvInitInfoString(&infoString, buffer, bufferSize);
 
     buffer[0] = '\0';
 
@@ -1682,6 +1682,7 @@ static void LogEdid(NVDpyEvoPtr pDpyEvo, NVEvoInfoStringPtr pInfoString)
             NVT_TIMING_TYPE type =
                 NVT_GET_TIMING_STATUS_TYPE(pTiming->etc.status);
             int vScale = 1;
+            char bpcString[32];
 
             if (mode_type_table[k].type != type) {
                 continue;
@@ -1779,25 +1780,33 @@ static void LogEdid(NVDpyEvoPtr pDpyEvo, NVEvoInfoStringPtr pInfoString)
             if (IS_BPC_SUPPORTED_COLORFORMAT(pTiming->etc.rgb444.bpcs)) {
                 nvEvoLogInfoString(pInfoString,
                                    "    RGB 444 bpcs     : %s",
-                                   GetColorDepthBpc(pTiming->etc.rgb444));
+                                   GetColorDepthBpc(pTiming->etc.rgb444,
+                                                    bpcString,
+                                                    sizeof(bpcString)));
             }
 
             if (IS_BPC_SUPPORTED_COLORFORMAT(pTiming->etc.yuv444.bpcs)) {
                 nvEvoLogInfoString(pInfoString,
                                    "    YUV 444 bpcs     : %s",
-                                   GetColorDepthBpc(pTiming->etc.yuv444));
+                                   GetColorDepthBpc(pTiming->etc.yuv444,
+                                                    bpcString,
+                                                    sizeof(bpcString)));
             }
 
             if (IS_BPC_SUPPORTED_COLORFORMAT(pTiming->etc.yuv422.bpcs)) {
                 nvEvoLogInfoString(pInfoString,
                                    "    YUV 422 bpcs     : %s",
-                                   GetColorDepthBpc(pTiming->etc.yuv422));
+                                   GetColorDepthBpc(pTiming->etc.yuv422,
+                                                    bpcString,
+                                                    sizeof(bpcString)));
             }
 
             if (IS_BPC_SUPPORTED_COLORFORMAT(pTiming->etc.yuv420.bpcs)) {
                 nvEvoLogInfoString(pInfoString,
                                    "    YUV 420 bpcs     : %s",
-                                   GetColorDepthBpc(pTiming->etc.yuv420));
+                                   GetColorDepthBpc(pTiming->etc.yuv420,
+                                                    bpcString,
+                                                    sizeof(bpcString)));
             }
         } // i
     } // k
@@ -2008,27 +2017,125 @@ static void CreateParsedEdidFromNVT_TIMING(
 }
 
 /*
- * PatchAndParseEdid() - use the nvtiming library to parse the EDID data.  The
- * EDID data provided in the 'pEdid' argument may be patched or modified.
+ * LookupParsedEdidCache() - look for a cached parse of the given EDID bytes.
+ * On a hit, copy the cached result into 'pParsedEdid' and move the entry to
+ * the front of the cache.
  */
 
-static void PatchAndParseEdid(
-    const NVDpyEvoRec *pDpyEvo,
-    NVEdidPtr pEdid,
-    NVParsedEdidEvoPtr pParsedEdid,
-    NVEvoInfoStringPtr pInfoString)
+static NvBool LookupParsedEdidCache(
+    NVDevEvoPtr pDevEvo,
+    const NVEdidRec *pEdid,
+    NvU32 crc32,
+    NVParsedEdidEvoPtr pParsedEdid)
 {
-    int i;
-    NVT_STATUS status;
-    NvU32 edidSize;
+    NVParsedEdidCacheEntryRec **entries = pDevEvo->parsedEdidCache.entries;
+    NvU32 i;
 
-    if (pEdid->buffer == NULL || pEdid->length == 0) {
+    for (i = 0; i < ARRAY_LEN(pDevEvo->parsedEdidCache.entries); i++) {
+        NVParsedEdidCacheEntryRec *pEntry = entries[i];
+
+        if (pEntry == NULL) {
+            break;
+        }
+
+        if ((pEntry->crc32 != crc32) ||
+            (pEntry->edidLength != pEdid->length) ||
+            (nvkms_memcmp(pEntry->edidBuffer, pEdid->buffer,
+                          pEdid->length) != 0)) {
+            continue;
+        }
+
+        nvkms_memcpy(pParsedEdid, &pEntry->parsedEdid, sizeof(*pParsedEdid));
+
+        for (; i > 0; i--) {
+            entries[i] = entries[i - 1];
+        }
+        entries[0] = pEntry;
+
+        pDevEvo->parsedEdidCache.hits++;
+
+        return TRUE;
+    }
+
+    pDevEvo->parsedEdidCache.misses++;
+
+    return FALSE;
+}
+
+/*
+ * InsertParsedEdidCache() - record a successful parse of the given EDID
+ * bytes at the front of the cache, evicting the least recently used entry
+ * if the cache is full.  Failure to allocate is not an error; the EDID just
+ * won't be cached.
+ */
+
+static void InsertParsedEdidCache(
+    NVDevEvoPtr pDevEvo,
+    const NVEdidRec *pEdid,
+    NvU32 crc32,
+    const NVParsedEdidEvoRec *pParsedEdid)
+{
+    NVParsedEdidCacheEntryRec **entries = pDevEvo->parsedEdidCache.entries;
+    const NvU32 last = ARRAY_LEN(pDevEvo->parsedEdidCache.entries) - 1;
+    NVParsedEdidCacheEntryRec *pEntry = entries[last];
+    NvU8 *edidBuffer;
+    NvU32 i;
+
+    edidBuffer = nvAlloc(pEdid->length);
+    if (edidBuffer == NULL) {
         return;
     }
 
-    nvkms_memset(pParsedEdid, 0, sizeof(*pParsedEdid));
+    if (pEntry == NULL) {
+        pEntry = nvAlloc(sizeof(*pEntry));
+        if (pEntry == NULL) {
+            nvFree(edidBuffer);
+            return;
+        }
+    } else {
+        nvFree(pEntry->edidBuffer);
+    }
 
-    PrePatchEdid(pDpyEvo, pEdid, pInfoString);
+    nvkms_memcpy(edidBuffer, pEdid->buffer, pEdid->length);
+
+    pEntry->crc32 = crc32;
+    pEntry->edidBuffer = edidBuffer;
+    pEntry->edidLength = pEdid->length;
+    nvkms_memcpy(&pEntry->parsedEdid, pParsedEdid, sizeof(*pParsedEdid));
+
+    for (i = last; i > 0; i--) {
+        entries[i] = entries[i - 1];
+    }
+    entries[0] = pEntry;
+}
+
+void nvDpyFreeParsedEdidCache(NVDevEvoPtr pDevEvo)
+{
+    NvU32 i;
+
+    for (i = 0; i < ARRAY_LEN(pDevEvo->parsedEdidCache.entries); i++) {
+        NVParsedEdidCacheEntryRec *pEntry =
+            pDevEvo->parsedEdidCache.entries[i];
+
+        if (pEntry != NULL) {
+            nvFree(pEntry->edidBuffer);
+            nvFree(pEntry);
+            pDevEvo->parsedEdidCache.entries[i] = NULL;
+        }
+    }
+}
+
+/*
+ * ParseEdid() - use the nvtiming library to parse the (already patched) EDID
+ * data into 'pParsedEdid'.  'pParsedEdid' is left invalid on failure.
+ */
+
+static void ParseEdid(
+    const NVEdidRec *pEdid,
+    NVParsedEdidEvoPtr pParsedEdid)
+{
+    int i;
+    NVT_STATUS status;
 
     /* parse the majority of information from the EDID */
 
@@ -2088,6 +2195,46 @@ static void PatchAndParseEdid(
     }
 
     pParsedEdid->valid = TRUE;
+}
+
+/*
+ * PatchAndParseEdid() - use the nvtiming library to parse the EDID data.  The
+ * EDID data provided in the 'pEdid' argument may be patched or modified.
+ *
+ * The parse is a pure function of the patched EDID bytes, so it is looked up
+ * in (and added to) the device's parsed EDID cache, keyed by those bytes.
+ */
+
+static void PatchAndParseEdid(
+    const NVDpyEvoRec *pDpyEvo,
+    NVEdidPtr pEdid,
+    NVParsedEdidEvoPtr pParsedEdid,
+    NVEvoInfoStringPtr pInfoString)
+{
+    NVDevEvoPtr pDevEvo = pDpyEvo->pDispEvo->pDevEvo;
+    NvU32 edidSize;
+    NvU32 crc32;
+
+    if (pEdid->buffer == NULL || pEdid->length == 0) {
+        return;
+    }
+
+    nvkms_memset(pParsedEdid, 0, sizeof(*pParsedEdid));
+
+    PrePatchEdid(pDpyEvo, pEdid, pInfoString);
+
+    crc32 = NvTiming_CalculateEDIDCRC32(pEdid->buffer, pEdid->length);
+
+    if (!LookupParsedEdidCache(pDevEvo, pEdid, crc32, pParsedEdid)) {
+
+        ParseEdid(pEdid, pParsedEdid);
+
+        if (!pParsedEdid->valid) {
+            return;
+        }
+
+        InsertParsedEdidCache(pDevEvo, pEdid, crc32, pParsedEdid);
+    }
 
     /* resize the EDID buffer, if necessary */
 
@@ -103,8 +103,8 @@ static NvBool ApplyLockActionIfPossible(NVDispEvoPtr pDispEvo,
                                         NVEvoLockAction action);
 static void FinishModesetOneTopology(RasterLockTopology *topo);
 
-static void SyncEvoLockState(void);
-static void UpdateEvoLockState(void);
+static void SyncEvoLockState(const NVDevEvoRec *pScopeDevEvo);
+static void UpdateEvoLockState(const NVDevEvoRec *pScopeDevEvo);
 
 static void ScheduleLutUpdate(NVDispEvoRec *pDispEvo,
                               const NvU32 head, const NvU32 data,
@@ -1059,7 +1059,7 @@ static void UnlockRasterLockGroup(NVDevEvoPtr pDevEvo) {
             NVEvoSubDevPtr pEvoSubDev = &pDevEvo->gpus[sd];
 
             /* Initialize the assembly state */
-            SyncEvoLockState();
+            SyncEvoLockState(pDevEvo);
 
             /* We want to evaluate all of these, so don't use || */
             changed |= ApplyLockActionIfPossible(pDispEvo, pEvoSubDev,
@@ -1071,7 +1071,7 @@ static void UnlockRasterLockGroup(NVDevEvoPtr pDevEvo) {
 
             /* Finally, update the hardware if anything has changed */
             if (changed) {
-                UpdateEvoLockState();
+                UpdateEvoLockState(pDevEvo);
                 changed = FALSE;
             }
 
@@ -1192,7 +1192,7 @@ static NvBool EnableVrr(NVDispEvoPtr pDispEvo,
 {
     NvBool ret;
 
-    SyncEvoLockState();
+    SyncEvoLockState(pDispEvo->pDevEvo);
 
     ret = pEvoSubDev->scanLockState(pDispEvo, pEvoSubDev, NV_EVO_ENABLE_VRR,
                                     pHeads);
@@ -1202,7 +1202,7 @@ static NvBool EnableVrr(NVDispEvoPtr pDispEvo,
         return FALSE;
     }
 
-    UpdateEvoLockState();
+    UpdateEvoLockState(pDispEvo->pDevEvo);
 
     return TRUE;
 }
@@ -1382,7 +1382,7 @@ exitHeadLoop:
         NvBool headsLocked = FALSE, gpusLocked = FALSE;
 
         /* Initialize the assembly state */
-        SyncEvoLockState();
+        SyncEvoLockState(pDevEvo);
 
         /* If we're past the end of the chain, we're done. */
         if (i == numUsedGpus) {
@@ -1510,7 +1510,7 @@ exitHeadLoop:
         /* If anything changed, update the hardware */
         if (headsLocked || gpusLocked) {
 
-            UpdateEvoLockState();
+            UpdateEvoLockState(pDevEvo);
 
             /*
              * Enable fliplock, if we can
@@ -2117,13 +2117,28 @@ static NvBool SetStereoLockMode(NVDispEvoPtr pDispEvo, NvBool stereoLocked)
     return TRUE;
 }
 
+/*
+ * Return whether the lock state machine, when run on behalf of pScopeDevEvo,
+ * needs to visit pDevEvo.  Without framelock, rasterlock and fliplock never
+ * span devices, so only the device being modeset is touched; this is what
+ * lets mode sets run under that device's lock alone.  With framelock devices
+ * present, every device may be affected and all of them are visited (the
+ * caller then holds the global NVKMS lock).
+ */
+static NvBool LockStateDevIsInScope(const NVDevEvoRec *pDevEvo,
+                                    const NVDevEvoRec *pScopeDevEvo)
+{
+    return (pDevEvo == pScopeDevEvo) ||
+           !nvListIsEmpty(&nvEvoGlobal.frameLockList);
+}
+
 /*
  * SyncEvoLockState()
  *
  * Set the Assembly state based on the current Armed state.  This should be
  * called before transitioning between states in the EVO state machine.
  */
-static void SyncEvoLockState(void)
+static void SyncEvoLockState(const NVDevEvoRec *pScopeDevEvo)
 {
     NVDispEvoPtr pDispEvo;
     unsigned int sd;
@@ -2131,6 +2146,10 @@ static void SyncEvoLockState(void)
 
     FOR_ALL_EVO_DEVS(pDevEvo) {
 
+        if (!LockStateDevIsInScope(pDevEvo, pScopeDevEvo)) {
+            continue;
+        }
+
         if (!pDevEvo->gpus) {
             continue;
         }
@@ -2338,7 +2357,7 @@ NvBool nvFramelockSetControlUnsyncEvo(NVDispEvoPtr pDispEvo, const NvU32 headMas
  * states in the EVO state machine to propagate all of the necessary values to
  * HW.
  */
-static void UpdateEvoLockState(void)
+static void UpdateEvoLockState(const NVDevEvoRec *pScopeDevEvo)
 {
     NVDispEvoPtr pDispEvo;
     NVFrameLockEvoPtr pFrameLockEvo;
@@ -2371,6 +2390,10 @@ static void UpdateEvoLockState(void)
      * frame locked, and if all heads are not using interlaced mode.
      */
     FOR_ALL_EVO_DEVS(pDevEvo) {
+        if (!LockStateDevIsInScope(pDevEvo, pScopeDevEvo)) {
+            continue;
+        }
+
         if (!pDevEvo->gpus) {
             continue;
         }
@@ -2481,6 +2504,10 @@ static void UpdateEvoLockState(void)
 
         FOR_ALL_EVO_DEVS(pDevEvo) {
 
+            if (!LockStateDevIsInScope(pDevEvo, pScopeDevEvo)) {
+                continue;
+            }
+
             if (!pDevEvo->gpus) {
                 continue;
             }
@@ -2601,6 +2628,10 @@ static void UpdateEvoLockState(void)
      */
     FOR_ALL_EVO_DEVS(pDevEvo) {
 
+        if (!LockStateDevIsInScope(pDevEvo, pScopeDevEvo)) {
+            continue;
+        }
+
         if (!pDevEvo->gpus) {
             continue;
         }
@@ -2683,6 +2714,10 @@ static void UpdateEvoLockState(void)
 
         FOR_ALL_EVO_DEVS(pDevEvo) {
 
+            if (!LockStateDevIsInScope(pDevEvo, pScopeDevEvo)) {
+                continue;
+            }
+
             if (!pDevEvo->gpus) {
                 continue;
             }
@@ -2849,7 +2884,7 @@ NvBool nvEnableFrameLockEvo(NVDispEvoPtr pDispEvo)
     }
 
     /* Initialize the assembly state */
-    SyncEvoLockState();
+    SyncEvoLockState(pDispEvo->pDevEvo);
 
     /* Enable the server */
     if ((serverHead != NV_INVALID_HEAD) &&
@@ -2889,7 +2924,7 @@ NvBool nvEnableFrameLockEvo(NVDispEvoPtr pDispEvo)
     pDispEvo->framelock.currentClientHeadsMask = activeClientHeadsMask;
 
     /* Finally, update the hardware */
-    UpdateEvoLockState();
+    UpdateEvoLockState(pDispEvo->pDevEvo);
 
     return TRUE;
 }
@@ -2907,7 +2942,7 @@ NvBool nvDisableFrameLockEvo(NVDispEvoPtr pDispEvo)
     NvU32 head;
 
     /* Initialize the assembly state */
-    SyncEvoLockState();
+    SyncEvoLockState(pDispEvo->pDevEvo);
 
     /* Disable the clients */
     activeClientHeadsMask = 0;
@@ -2947,7 +2982,7 @@ NvBool nvDisableFrameLockEvo(NVDispEvoPtr pDispEvo)
     }
 
     /* Finally, update the hardware */
-    UpdateEvoLockState();
+    UpdateEvoLockState(pDispEvo->pDevEvo);
 
     return TRUE;
 }
@@ -6715,6 +6750,12 @@ NvBool nvFreeDevEvo(NVDevEvoPtr pDevEvo)
 
     nvkms_free_ref_ptr(pDevEvo->ref_ptr);
 
+    nvDpyFreeParsedEdidCache(pDevEvo);
+
+    if (pDevEvo->pDeviceLock != NULL) {
+        nvkms_sema_free(pDevEvo->pDeviceLock);
+    }
+
     nvFree(pDevEvo);
     return TRUE;
 }
@@ -6748,6 +6789,11 @@ NVDevEvoPtr nvAllocDevEvo(const struct NvKmsAllocDeviceRequest *pRequest,
         goto done;
     }
 
+    pDevEvo->pDeviceLock = nvkms_sema_alloc();
+    if (pDevEvo->pDeviceLock == NULL) {
+        goto done;
+    }
+
     for (i = 0; i < ARRAY_LEN(pDevEvo->openedGpuIds); i++) {
         pDevEvo->openedGpuIds[i] = NV0000_CTRL_GPU_INVALID_ID;
     }
@@ -1259,10 +1259,12 @@ static const char *GetCea861AudioFormatInfo(NvU8 format,
  * described in the CEA-861 specification's description of byte 2 in
  * the Audio Descriptor Block.
  *
- * Note the return value is a static char * and will be overwritten in
- * subsequent calls to this function.
+ * The description is written to the caller-provided sampleRateString
+ * buffer, which is also returned.
  */
-static const char *GetCea861AudioSampleRateString(NvU8 sampleRates)
+static const char *GetCea861AudioSampleRateString(NvU8 sampleRates,
+                                                  char *sampleRateString,
+                                                  size_t bufferSize)
 {
     static const struct {
         NvU8 rate;
@@ -1277,12 +1279,10 @@ static const char *GetCea861AudioSampleRateString(NvU8 sampleRates)
         { NVT_CEA861_AUDIO_SAMPLE_RATE_192KHZ,"192KHz" },
     };
 
-    static char sampleRateString[64];
-
     NvBool first = TRUE;
     int i;
     char *s;
-    int ret, bytesLeft = sizeof(sampleRateString);
+    int ret, bytesLeft = bufferSize;
 
     sampleRateString[0] = '\0';
     s = sampleRateString;
@@ -1313,10 +1313,12 @@ static const char *GetCea861AudioSampleRateString(NvU8 sampleRates)
  * described in the CEA-861 specification's description of byte 3 in
  * the Audio Descriptor Block.
  *
- * Note the return value is a static char * and will be overwritten in
- * subsequent calls to this function.
+ * The description is written to the caller-provided sampleSizeString
+ * buffer, which is also returned.
  */
-static const char *GetCea861AudioSampleSizeString(NvU8 sampleSizes)
+static const char *GetCea861AudioSampleSizeString(NvU8 sampleSizes,
+                                                  char *sampleSizeString,
+                                                  size_t bufferSize)
 {
     static const struct {
         NvU8 bit;
@@ -1327,12 +1329,10 @@ static const char *GetCea861AudioSampleSizeString(NvU8 sampleSizes)
         { NVT_CEA861_AUDIO_SAMPLE_SIZE_24BIT, "24-bits" },
     };
 
-    static char sampleSizeString[64];
-
     NvBool first = TRUE;
     int i;
     char *s;
-    int ret, bytesLeft = sizeof(sampleSizeString);
+    int ret, bytesLeft = bufferSize;
 
     sampleSizeString[0] = '\0';
     s = sampleSizeString;
@@ -1450,6 +1450,8 @@ static void LogEdidCea861Info(NVEvoInfoStringPtr pInfoString,
         const char *formatString;
         NvBool hasSampleSize;
         NvBool hasMaxBitRate;
+        char sampleRateString[64];
+        char sampleSizeString[64];
 
         byte1 = pExt861->audio[audioIndex].byte1;
         byte2 = pExt861->audio[audioIndex].byte2;
@@ -1491,11 +1493,15 @@ static void LogEdidCea861Info(NVEvoInfoStringPtr pInfoString,
                            "   Maximum Channels          : %d", maxChannels);
         nvEvoLogInfoString(pInfoString,
                            "   Sample Rates              : %s",
-                           GetCea861AudioSampleRateString(sampleRates));
+                           GetCea861AudioSampleRateString(
+                               sampleRates, sampleRateString,
+                               sizeof(sampleRateString)));
         if (hasSampleSize) {
             nvEvoLogInfoString(pInfoString,
                                "   Sample Sizes              : %s",
-                               GetCea861AudioSampleSizeString(byte3));
+                               GetCea861AudioSampleSizeString(
+                                   byte3, sampleSizeString,
+                                   sizeof(sampleSizeString)));
         }
         if (hasMaxBitRate) {
             nvEvoLogInfoString(pInfoString,
@@ -1233,6 +1233,17 @@ static void FreeDpys(NVDispEvoPtr pDispEvo)
 }
 
 
+/*!
+ * Return the device lock for the pDispEvo a hotplug or DP IRQ timer refers
+ * to, so that the deferred work runs under that device's lock.
+ */
+static nvkms_sema_handle_t *GetDispEvoDeviceLock(void *dataPtr)
+{
+    const NVDispEvoRec *pDispEvo = dataPtr;
+
+    return pDispEvo->pDevEvo->pDeviceLock;
+}
+
 /*!
  * Receive hotplug notification from resman.
  *
@@ -1246,11 +1257,12 @@ static void FreeDpys(NVDispEvoPtr pDispEvo)
 static void ReceiveHotplugEvent(void *arg, void *pEventDataVoid, NvU32 hEvent,
                                 NvU32 Data, NV_STATUS Status)
 {
-    (void) nvkms_alloc_timer_with_ref_ptr(
+    (void) nvkms_alloc_device_timer_with_ref_ptr(
         nvHandleHotplugEventDeferredWork, /* callback */
         arg, /* argument (this is a ref_ptr to a pDispEvo) */
         0,   /* dataU32 */
-        0);
+        0,
+        GetDispEvoDeviceLock);
 }
 
 static void ReceiveDPIRQEvent(void *arg, void *pEventDataVoid, NvU32 hEvent,
@@ -1259,11 +1271,12 @@ static void ReceiveDPIRQEvent(void *arg, void *pEventDataVoid, NvU32 hEvent,
     // XXX The displayId of the connector that generated the event should be
     // available here somewhere.  We should figure out how to find that and
     // plumb it through to nvHandleDPIRQEventDeferredWork.
-    (void) nvkms_alloc_timer_with_ref_ptr(
+    (void) nvkms_alloc_device_timer_with_ref_ptr(
         nvHandleDPIRQEventDeferredWork, /* callback */
         arg, /* argument (this is a ref_ptr to a pDispEvo) */
         0,   /* dataU32 */
-        0);
+        0,
+        GetDispEvoDeviceLock);
 }
 
 NvBool nvRmRegisterCallback(const NVDevEvoRec *pDevEvo,
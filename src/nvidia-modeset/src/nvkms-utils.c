@@ -202,95 +202,179 @@ void nvEvoLogInfoString(NVEvoInfoStringPtr pInfoString,
  * devices, disps, connectors, surfaces) clients will specify the
  * object by handle, and NVKMS will look up the corresponding object.
  *
- * We store a pointer to the object in a dynamically allocated array,
- * and use the handle to look up the pointer in the array.
+ * We store a pointer to the object in a dynamically allocated array
+ * of slots, and use the handle to look up the slot in the array.
+ *
+ * Free slots are chained into a free list through
+ * NVEvoApiHandleSlotRec::nextFree, so that creating a handle does not
+ * need to search for a free slot.  The indices of the used slots are
+ * also kept densely packed in the liveSlots array, so that iterating
+ * over the handles only visits used slots.
  *
  * Note that handles are 1-based (valid handles are in the range
- * [1,numPointers], and 0 is an invalid handle), while indices to the
- * corresponding pointers are 0-based (valid indices are in the range
- * [0,numPointers-1]).  Subtract 1 from the handle to get the index
- * for the pointer.
+ * [1,numSlots], and 0 is an invalid handle), while indices to the
+ * corresponding slots are 0-based (valid indices are in the range
+ * [0,numSlots-1]).  Subtract 1 from the handle to get the index
+ * for the slot.  The free list links are 1-based as well, so that 0
+ * terminates the list.
  */
 
 /*!
- * Increase the size of the NVEvoApiHandles::pointers array.
+ * Resize the NVEvoApiHandles::slots and liveSlots arrays.
  *
- * Reallocate the pointers array, increasing by defaultSize.
- * Initialize the new region of memory.
+ * Slots being added are initialized as free, but are not added to the
+ * free list.
  */
-static NvBool GrowApiHandlesPointersArray(NVEvoApiHandlesPtr pEvoApiHandles)
+static NvBool ResizeApiHandlesSlotsArray(NVEvoApiHandlesPtr pEvoApiHandles,
+                                         NvU32 newNumSlots)
 {
-    NvU32 newNumPointers =
-        pEvoApiHandles->numPointers + pEvoApiHandles->defaultSize;
-    size_t oldSize = pEvoApiHandles->numPointers * sizeof(void *);
-    size_t newSize = newNumPointers * sizeof(void *);
-    void **newPointers;
+    const size_t newSlotsSize = newNumSlots * sizeof(NVEvoApiHandleSlotRec);
+    const size_t newLiveSize = newNumSlots * sizeof(NvU32);
+    NVEvoApiHandleSlotRec *newSlots;
+    NvU32 *newLiveSlots;
 
-    /* Check for wrap in the newNumPointers computation. */
-    if (newSize <= oldSize) {
+    /* Check for wrap in the array size computations. */
+    if ((newSlotsSize / sizeof(NVEvoApiHandleSlotRec)) != newNumSlots) {
         return FALSE;
     }
 
-    newPointers = nvRealloc(pEvoApiHandles->pointers, newSize);
+    nvAssert(newNumSlots >= pEvoApiHandles->numLive);
+
+    newLiveSlots = nvRealloc(pEvoApiHandles->liveSlots, newLiveSize);
 
-    if (newPointers == NULL) {
+    if (newLiveSlots == NULL) {
         return FALSE;
     }
 
-    nvkms_memset(&newPointers[pEvoApiHandles->numPointers], 0, newSize - oldSize);
+    pEvoApiHandles->liveSlots = newLiveSlots;
+
+    newSlots = nvRealloc(pEvoApiHandles->slots, newSlotsSize);
 
-    pEvoApiHandles->pointers = newPointers;
-    pEvoApiHandles->numPointers = newNumPointers;
+    if (newSlots == NULL) {
+        /*
+         * Leave the liveSlots reallocation in place: it holds at least
+         * numLive elements either way.
+         */
+        return FALSE;
+    }
+
+    if (newNumSlots > pEvoApiHandles->numSlots) {
+        nvkms_memset(&newSlots[pEvoApiHandles->numSlots], 0,
+                     (newNumSlots - pEvoApiHandles->numSlots) *
+                     sizeof(NVEvoApiHandleSlotRec));
+    }
+
+    pEvoApiHandles->slots = newSlots;
+    pEvoApiHandles->numSlots = newNumSlots;
 
     return TRUE;
 }
 
 
 /*!
- * Attempt to shrink the NVEvoApiHandles::pointers array.
+ * Push the slot at 'index' onto the head of the free list.
+ */
+static void PushApiHandlesFreeSlot(NVEvoApiHandlesPtr pEvoApiHandles,
+                                   NvU32 index)
+{
+    nvAssert(pEvoApiHandles->slots[index].pointer == NULL);
+
+    pEvoApiHandles->slots[index].nextFree = pEvoApiHandles->freeHead;
+    pEvoApiHandles->freeHead = index + 1;
+}
+
+
+/*!
+ * Increase the size of the NVEvoApiHandles::slots array.
+ *
+ * Reallocate the slots array, increasing by defaultSize, and add the
+ * new slots to the free list so that the lowest one is used first.
+ */
+static NvBool GrowApiHandlesSlotsArray(NVEvoApiHandlesPtr pEvoApiHandles)
+{
+    const NvU32 oldNumSlots = pEvoApiHandles->numSlots;
+    const NvU32 newNumSlots = oldNumSlots + pEvoApiHandles->defaultSize;
+    NvU32 index;
+
+    /* Check for wrap in the newNumSlots computation. */
+    if (newNumSlots <= oldNumSlots) {
+        return FALSE;
+    }
+
+    if (!ResizeApiHandlesSlotsArray(pEvoApiHandles, newNumSlots)) {
+        return FALSE;
+    }
+
+    for (index = newNumSlots; index > oldNumSlots; index--) {
+        PushApiHandlesFreeSlot(pEvoApiHandles, index - 1);
+    }
+
+    pEvoApiHandles->shrinkNumLive = newNumSlots / 4;
+
+    return TRUE;
+}
+
+
+/*!
+ * Attempt to shrink the NVEvoApiHandles::slots array.
  *
  * If high elements in the array are unused, reduce the array size in
- * multiples of defaultSize.
+ * multiples of defaultSize, and rebuild the free list from the slots
+ * that remain.
+ *
+ * Finding the highest used slot costs O(numLive), so this is only
+ * attempted each time numLive halves, or drops to a quarter of the
+ * array size after the array grows.
+ *
+ * This is called when creating a handle; handles must not be created
+ * while iterating with FOR_ALL_POINTERS_IN_EVO_API_HANDLES().
  */
-static void ShrinkApiHandlesPointersArray(NVEvoApiHandlesPtr pEvoApiHandles)
+static void ShrinkApiHandlesSlotsArray(NVEvoApiHandlesPtr pEvoApiHandles)
 {
+    NvU32 pos;
     NvU32 index;
-    NvU32 newNumPointers;
-    void **newPointers;
+    NvU32 maxIndex = 0;
+    NvU32 newNumSlots;
+
+    pEvoApiHandles->shrinkNumLive = pEvoApiHandles->numLive / 2;
 
     /* If the array is already as small as it can be, we are done. */
 
-    if (pEvoApiHandles->numPointers == pEvoApiHandles->defaultSize) {
+    if (pEvoApiHandles->numSlots == pEvoApiHandles->defaultSize) {
         return;
     }
 
     /* Find the highest non-empty element. */
 
-    for (index = pEvoApiHandles->numPointers - 1; index > 0; index--) {
-        if (pEvoApiHandles->pointers[index] != NULL) {
-            break;
-        }
+    for (pos = 0; pos < pEvoApiHandles->numLive; pos++) {
+        maxIndex = NV_MAX(maxIndex, pEvoApiHandles->liveSlots[pos]);
     }
 
     /*
-     * Compute the new array size by rounding index up to the next
+     * Compute the new array size by rounding maxIndex up to the next
      * multiple of defaultSize.
      */
-    newNumPointers = ((index / pEvoApiHandles->defaultSize) + 1) *
+    newNumSlots = ((maxIndex / pEvoApiHandles->defaultSize) + 1) *
         pEvoApiHandles->defaultSize;
 
     /* If the array is already that size, we are done. */
 
-    if (pEvoApiHandles->numPointers == newNumPointers) {
+    if (pEvoApiHandles->numSlots == newNumSlots) {
         return;
     }
 
-    newPointers =
-        nvRealloc(pEvoApiHandles->pointers, newNumPointers * sizeof(void *));
+    if (!ResizeApiHandlesSlotsArray(pEvoApiHandles, newNumSlots)) {
+        return;
+    }
+
+    /* Drop the truncated slots from the free list. */
 
-    if (newPointers != NULL) {
-        pEvoApiHandles->pointers = newPointers;
-        pEvoApiHandles->numPointers = newNumPointers;
+    pEvoApiHandles->freeHead = 0;
+
+    for (index = newNumSlots; index > 0; index--) {
+        if (pEvoApiHandles->slots[index - 1].pointer == NULL) {
+            PushApiHandlesFreeSlot(pEvoApiHandles, index - 1);
+        }
     }
 }
 
@@ -301,10 +385,12 @@ static void ShrinkApiHandlesPointersArray(NVEvoApiHandlesPtr pEvoApiHandles)
 NvBool nvEvoApiHandlePointerIsPresent(NVEvoApiHandlesPtr pEvoApiHandles,
                                       void *pointer)
 {
-    NvU32 index;
+    NvU32 pos;
+
+    for (pos = 0; pos < pEvoApiHandles->numLive; pos++) {
+        const NvU32 index = pEvoApiHandles->liveSlots[pos];
 
-    for (index = 0; index < pEvoApiHandles->numPointers; index++) {
-        if (pEvoApiHandles->pointers[index] == pointer) {
+        if (pEvoApiHandles->slots[index].pointer == pointer) {
             return TRUE;
         }
     }
@@ -322,34 +408,46 @@ NvBool nvEvoApiHandlePointerIsPresent(NVEvoApiHandlesPtr pEvoApiHandles,
 NvKmsGenericHandle
 nvEvoCreateApiHandle(NVEvoApiHandlesPtr pEvoApiHandles, void *pointer)
 {
+    NVEvoApiHandleSlotRec *pSlot;
     NvU32 index;
 
     if (pointer == NULL) {
         return 0;
     }
 
-    for (index = 0; index < pEvoApiHandles->numPointers; index++) {
-        if (pEvoApiHandles->pointers[index] == NULL) {
-            goto availableIndex;
-        }
+    /*
+     * Shrinking is deferred from nvEvoDestroyApiHandle() to here, so that
+     * destroying handles while iterating over them never truncates the
+     * slot of the handle being visited.
+     */
+    if (pEvoApiHandles->numLive <= pEvoApiHandles->shrinkNumLive) {
+        ShrinkApiHandlesSlotsArray(pEvoApiHandles);
     }
 
     /*
-     * Otherwise, there are no free elements in the pointers array:
-     * grow the array and try again.
+     * If there are no free elements in the slots array, grow the
+     * array.
      */
-    if (!GrowApiHandlesPointersArray(pEvoApiHandles)) {
+    if ((pEvoApiHandles->freeHead == 0) &&
+        !GrowApiHandlesSlotsArray(pEvoApiHandles)) {
         return 0;
     }
 
-    /* fall through */
+    index = pEvoApiHandles->freeHead - 1;
+
+    nvAssert(index < pEvoApiHandles->numSlots);
 
-availableIndex:
+    pSlot = &pEvoApiHandles->slots[index];
 
-    nvAssert(index < pEvoApiHandles->numPointers);
-    nvAssert(pEvoApiHandles->pointers[index] == NULL);
+    nvAssert(pSlot->pointer == NULL);
 
-    pEvoApiHandles->pointers[index] = pointer;
+    pEvoApiHandles->freeHead = pSlot->nextFree;
+
+    pSlot->pointer = pointer;
+    pSlot->livePos = pEvoApiHandles->numLive;
+    pSlot->nextFree = 0;
+
+    pEvoApiHandles->liveSlots[pEvoApiHandles->numLive++] = index;
 
     return index + 1;
 }
@@ -371,11 +469,11 @@ void *nvEvoGetPointerFromApiHandle(const NVEvoApiHandlesRec *pEvoApiHandles,
 
     index = handle - 1;
 
-    if (index >= pEvoApiHandles->numPointers) {
+    if (index >= pEvoApiHandles->numSlots) {
         return NULL;
     }
 
-    return pEvoApiHandles->pointers[index];
+    return pEvoApiHandles->slots[index].pointer;
 }
 
 
@@ -384,26 +482,41 @@ void *nvEvoGetPointerFromApiHandle(const NVEvoApiHandlesRec *pEvoApiHandles,
  *
  * This is intended to be used by the
  * FOR_ALL_POINTERS_IN_EVO_API_HANDLES() macro.  On the first
- * iteration, *pHandle == 0, and this will return the first pointer it
- * finds in the pointer array.  The returned *pHandle will be the
- * location to begin searching on the next iteration, and so on.
+ * iteration, *pHandle == 0, and this will return the pointer of the
+ * last element in the liveSlots array.  The returned *pHandle is the
+ * handle of that pointer, and its slot's livePos is the location to
+ * continue walking liveSlots downwards from on the next iteration.
+ *
+ * Walking downwards makes it safe to destroy the current handle
+ * during iteration: nvEvoDestroyApiHandle() moves the last element of
+ * liveSlots, which has already been visited, into the destroyed
+ * handle's position, and the destroyed slot keeps its stale livePos.
  *
- * Once there are no more non-zero elements in the pointer array,
- * return NULL.
+ * Once there are no more elements in the liveSlots array, return NULL.
  */
 void *nvEvoGetPointerFromApiHandleNext(const NVEvoApiHandlesRec *pEvoApiHandles,
                                        NvKmsGenericHandle *pHandle)
 {
-    NvU32 index = *pHandle;
+    NvU32 pos;
+    NvU32 index;
 
-    for (; index < pEvoApiHandles->numPointers; index++) {
-        if (pEvoApiHandles->pointers[index] != NULL) {
-            *pHandle = index + 1;
-            return pEvoApiHandles->pointers[index];
-        }
+    if (*pHandle == 0) {
+        pos = pEvoApiHandles->numLive;
+    } else {
+        nvAssert((*pHandle - 1) < pEvoApiHandles->numSlots);
+        pos = pEvoApiHandles->slots[*pHandle - 1].livePos;
     }
 
-    return NULL;
+    pos = NV_MIN(pos, pEvoApiHandles->numLive);
+
+    if (pos == 0) {
+        return NULL;
+    }
+
+    index = pEvoApiHandles->liveSlots[pos - 1];
+
+    *pHandle = index + 1;
+    return pEvoApiHandles->slots[index].pointer;
 }
 
 
@@ -415,7 +528,9 @@ void *nvEvoGetPointerFromApiHandleNext(const NVEvoApiHandlesRec *pEvoApiHandles,
 void nvEvoDestroyApiHandle(NVEvoApiHandlesPtr pEvoApiHandles,
                            NvKmsGenericHandle handle)
 {
+    NVEvoApiHandleSlotRec *pSlot;
     NvU32 index;
+    NvU32 lastIndex;
 
     if (handle == 0) {
         return;
@@ -423,36 +538,29 @@ void nvEvoDestroyApiHandle(NVEvoApiHandlesPtr pEvoApiHandles,
 
     index = handle - 1;
 
-    if (index >= pEvoApiHandles->numPointers) {
+    if (index >= pEvoApiHandles->numSlots) {
         return;
     }
 
-    pEvoApiHandles->pointers[index] = NULL;
+    pSlot = &pEvoApiHandles->slots[index];
 
-    ShrinkApiHandlesPointersArray(pEvoApiHandles);
-}
+    if (pSlot->pointer == NULL) {
+        return;
+    }
 
+    /* Move the last element of liveSlots into the freed position. */
 
-/* Only used in nvAssert, so only build into debug builds to avoid never-used
- * warnings */
-#if defined(DEBUG)
-/*!
- * Return the number of non-NULL pointers in the pointer array.
- */
-static NvU32
-CountApiHandles(const NVEvoApiHandlesRec *pEvoApiHandles)
-{
-    NvU32 index, count = 0;
+    nvAssert(pEvoApiHandles->numLive > 0);
+    nvAssert(pEvoApiHandles->liveSlots[pSlot->livePos] == index);
 
-    for (index = 0; index < pEvoApiHandles->numPointers; index++) {
-        if (pEvoApiHandles->pointers[index] != NULL) {
-            count++;
-        }
-    }
+    lastIndex = pEvoApiHandles->liveSlots[--pEvoApiHandles->numLive];
+    pEvoApiHandles->liveSlots[pSlot->livePos] = lastIndex;
+    pEvoApiHandles->slots[lastIndex].livePos = pSlot->livePos;
 
-    return count;
+    pSlot->pointer = NULL;
+
+    PushApiHandlesFreeSlot(pEvoApiHandles, index);
 }
-#endif /* DEBUG */
 
 
 /*!
@@ -462,7 +570,7 @@ CountApiHandles(const NVEvoApiHandlesRec *pEvoApiHandles)
  * nvEvo{Create,GetPointerFrom,Destroy}ApiHandle() calls on this
  * pEvoApiHandles.
  *
- * The pointer array for the pEvoApiHandles will be managed in
+ * The slots array for the pEvoApiHandles will be managed in
  * multiples of 'defaultSize'.
  */
 NvBool nvEvoInitApiHandles(NVEvoApiHandlesPtr pEvoApiHandles, NvU32 defaultSize)
@@ -471,7 +579,7 @@ NvBool nvEvoInitApiHandles(NVEvoApiHandlesPtr pEvoApiHandles, NvU32 defaultSize)
 
     pEvoApiHandles->defaultSize = defaultSize;
 
-    return GrowApiHandlesPointersArray(pEvoApiHandles);
+    return GrowApiHandlesSlotsArray(pEvoApiHandles);
 }
 
 
@@ -480,9 +588,10 @@ NvBool nvEvoInitApiHandles(NVEvoApiHandlesPtr pEvoApiHandles, NvU32 defaultSize)
  */
 void nvEvoDestroyApiHandles(NVEvoApiHandlesPtr pEvoApiHandles)
 {
-    nvAssert(CountApiHandles(pEvoApiHandles) == 0);
+    nvAssert(pEvoApiHandles->numLive == 0);
 
-    nvFree(pEvoApiHandles->pointers);
+    nvFree(pEvoApiHandles->slots);
+    nvFree(pEvoApiHandles->liveSlots);
 
     nvkms_memset(pEvoApiHandles, 0, sizeof(*pEvoApiHandles));
 }
@@ -658,27 +767,65 @@ NvBool nvGetRegkeyValue(const NVDevEvoRec *pDevEvo,
 
 #include "nv_memory_tracker.h"
 
+/*
+ * The lock is allocated by nvKmsModuleLoad(); allocations made before that
+ * (and after nvKmsModuleUnload()) are single threaded.
+ */
+static void LockDebugMemoryAllocationList(void)
+{
+    if (nvEvoGlobal.debugMemoryAllocationLock != NULL) {
+        nvkms_sema_down(nvEvoGlobal.debugMemoryAllocationLock);
+    }
+}
+
+static void UnlockDebugMemoryAllocationList(void)
+{
+    if (nvEvoGlobal.debugMemoryAllocationLock != NULL) {
+        nvkms_sema_up(nvEvoGlobal.debugMemoryAllocationLock);
+    }
+}
+
 void *nvDebugAlloc(size_t size, int line, const char *file)
 {
-    return nvMemoryTrackerTrackedAlloc(&nvEvoGlobal.debugMemoryAllocationList,
-                                       size, line, file);
+    void *ptr;
+
+    LockDebugMemoryAllocationList();
+    ptr = nvMemoryTrackerTrackedAlloc(&nvEvoGlobal.debugMemoryAllocationList,
+                                      size, line, file);
+    UnlockDebugMemoryAllocationList();
+
+    return ptr;
 }
 
 void *nvDebugCalloc(size_t nmemb, size_t size, int line, const char *file)
 {
-    return nvMemoryTrackerTrackedCalloc(&nvEvoGlobal.debugMemoryAllocationList,
-                                        nmemb, size, line, file);
+    void *ptr;
+
+    LockDebugMemoryAllocationList();
+    ptr = nvMemoryTrackerTrackedCalloc(&nvEvoGlobal.debugMemoryAllocationList,
+                                       nmemb, size, line, file);
+    UnlockDebugMemoryAllocationList();
+
+    return ptr;
 }
 
 void *nvDebugRealloc(void *ptr, size_t size, int line, const char *file)
 {
-    return nvMemoryTrackerTrackedRealloc(&nvEvoGlobal.debugMemoryAllocationList,
-                                         ptr, size, line, file);
+    void *newPtr;
+
+    LockDebugMemoryAllocationList();
+    newPtr = nvMemoryTrackerTrackedRealloc(&nvEvoGlobal.debugMemoryAllocationList,
+                                           ptr, size, line, file);
+    UnlockDebugMemoryAllocationList();
+
+    return newPtr;
 }
 
 void nvDebugFree(void *ptr)
 {
+    LockDebugMemoryAllocationList();
     nvMemoryTrackerTrackedFree(ptr);
+    UnlockDebugMemoryAllocationList();
 }
 
 char *nvDebugStrDup(const char *str, int line, const char *file)
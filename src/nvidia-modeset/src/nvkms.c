@@ -200,6 +200,15 @@ static void FreeSurfaceCtxDmasForAllOpens(NVDevEvoRec *pDevEvo);
 static NVListRec perOpenList = NV_LIST_INIT(&perOpenList);
 static NVListRec perOpenIoctlList = NV_LIST_INIT(&perOpenIoctlList);
 
+/*
+ * Serializes appends to the per-open event queues.  Device-local paths (see
+ * nvKmsIoctlIsDeviceLocal()) on different devices may generate events for
+ * the same client concurrently.  Everything else that touches an event queue
+ * (popping, freeing the per-open) holds the global NVKMS lock exclusively
+ * and therefore cannot overlap with a device-local path.
+ */
+static nvkms_sema_handle_t *pEventListLock;
+
 /*!
  * Check if there is an NvKmsPerOpenDev on this NvKmsPerOpen that has
  * the specified deviceId.
@@ -1994,6 +2003,7 @@ static NvBool SetMode(struct NvKmsPerOpen *pOpen,
 {
     struct NvKmsSetModeParams *pParams = pParamsVoid;
     struct NvKmsPerOpenDev *pOpenDev;
+    NvBool ret;
 
     pOpenDev = GetPerOpenDev(pOpen, pParams->request.deviceHandle);
 
@@ -2001,10 +2011,16 @@ static NvBool SetMode(struct NvKmsPerOpen *pOpen,
         return FALSE;
     }
 
-    return nvSetDispModeEvo(pOpenDev->pDevEvo, pOpenDev,
-                            &pParams->request, &pParams->reply,
-                            FALSE /* bypassComposition */,
-                            TRUE /* doRasterLock */);
+    nvkms_sema_down(pOpenDev->pDevEvo->pDeviceLock);
+
+    ret = nvSetDispModeEvo(pOpenDev->pDevEvo, pOpenDev,
+                           &pParams->request, &pParams->reply,
+                           FALSE /* bypassComposition */,
+                           TRUE /* doRasterLock */);
+
+    nvkms_sema_up(pOpenDev->pDevEvo->pDeviceLock);
+
+    return ret;
 }
 
 static inline NvBool nvHsIoctlSetCursorImage(
@@ -2071,6 +2087,7 @@ static NvBool MoveCursor(struct NvKmsPerOpen *pOpen,
     struct NvKmsMoveCursorParams *pParams = pParamsVoid;
     struct NvKmsPerOpenDisp *pOpenDisp;
     NVDispEvoPtr pDispEvo;
+    NvBool ret;
 
     pOpenDisp = GetPerOpenDisp(pOpen,
                                pParams->request.deviceHandle,
@@ -2081,13 +2098,19 @@ static NvBool MoveCursor(struct NvKmsPerOpen *pOpen,
 
     pDispEvo = pOpenDisp->pDispEvo;
 
+    nvkms_sema_down(pDispEvo->pDevEvo->pDeviceLock);
+
     if (!nvHeadIsActive(pDispEvo, pParams->request.head)) {
-        return FALSE;
+        ret = FALSE;
+    } else {
+        ret = nvHsIoctlMoveCursor(pDispEvo,
+                                  pParams->request.head,
+                                  &pParams->request.common);
     }
 
-    return nvHsIoctlMoveCursor(pDispEvo,
-                               pParams->request.head,
-                               &pParams->request.common);
+    nvkms_sema_up(pDispEvo->pDevEvo->pDeviceLock);
+
+    return ret;
 }
 
 /* No extra user state needed for SetLut; although we lose the user pointers
@@ -2325,6 +2348,7 @@ static NvBool Flip(struct NvKmsPerOpen *pOpen,
 {
     struct NvKmsFlipParams *pParams = pParamsVoid;
     struct NvKmsPerOpenDev *pOpenDev;
+    NvBool ret;
 
     pOpenDev = GetPerOpenDev(pOpen, pParams->request.deviceHandle);
 
@@ -2332,8 +2356,14 @@ static NvBool Flip(struct NvKmsPerOpen *pOpen,
         return FALSE;
     }
 
-    return nvHsIoctlFlip(pOpenDev->pDevEvo, pOpenDev,
-                         &pParams->request, &pParams->reply);
+    nvkms_sema_down(pOpenDev->pDevEvo->pDeviceLock);
+
+    ret = nvHsIoctlFlip(pOpenDev->pDevEvo, pOpenDev,
+                        &pParams->request, &pParams->reply);
+
+    nvkms_sema_up(pOpenDev->pDevEvo->pDeviceLock);
+
+    return ret;
 }
 
 
@@ -3416,6 +3446,67 @@ static NvBool DisableVblankSyncObject(
     return TRUE;
 }
 
+/*!
+ * Return whether the ioctl only touches state owned by the device it
+ * targets, so that the caller may issue it without excluding ioctls to
+ * other devices.
+ *
+ * Device-local ioctls serialize against each other with the target
+ * device's pDeviceLock.  The caller must still exclude every other path
+ * into core NVKMS while a device-local ioctl is in flight, and must hold
+ * the global lock when calling this function.
+ *
+ * Flips, cursor moves and mode sets are device-local.  Mode sets are only
+ * device-local while no framelock devices are present: framelock ties the
+ * lock state of multiple devices together (see UpdateEvoLockState()), so
+ * mode sets on framelock-equipped systems still run under the global lock.
+ * Device, surface, framelock and event management ioctls always do,
+ * since they change state shared across devices and clients.
+ *
+ * \param[in]  pOpenVoid  The per-open data, allocated by nvKmsOpen().
+ * \param[in]  cmd        The NVKMS_IOCTL_ operation to perform.
+ *
+ * \return  Return TRUE if the ioctl is device-local.
+ */
+NvBool nvKmsIoctlIsDeviceLocal(void *pOpenVoid, NvU32 cmd)
+{
+    const struct NvKmsPerOpen *pOpen = pOpenVoid;
+
+    /*
+     * The first ioctl on a per-open initializes its ioctl state, which must
+     * not race with another ioctl on the same per-open.
+     */
+    if (pOpen->type != NvKmsPerOpenTypeIoctl) {
+        return FALSE;
+    }
+
+    switch (cmd) {
+    case NVKMS_IOCTL_FLIP:
+    case NVKMS_IOCTL_MOVE_CURSOR:
+        return TRUE;
+    case NVKMS_IOCTL_SET_MODE:
+        return nvListIsEmpty(&nvEvoGlobal.frameLockList);
+    default:
+        return FALSE;
+    }
+}
+
+/*!
+ * Return whether device timers (see nvkms_alloc_device_timer()) may run
+ * under their device lock alone, like device-local ioctls (see
+ * nvKmsIoctlIsDeviceLocal()).
+ *
+ * DisplayPort library timers and hotplug/DP IRQ handling may retrain links
+ * and update the lock state of their device, which spans devices once
+ * framelock is in use.
+ *
+ * The caller must hold the global lock when calling this function.
+ */
+NvBool nvKmsTimerIsDeviceLocal(void)
+{
+    return nvListIsEmpty(&nvEvoGlobal.frameLockList);
+}
+
 /*!
  * Perform the ioctl operation requested by the client.
  *
@@ -4323,6 +4414,106 @@ ProcFsPrintDpyCrcs(
     }
 }
 
+static void
+ProcFsPrintOneChannelStalls(
+    void *data,
+    char *buffer,
+    size_t size,
+    nvkms_procfs_out_string_func_t *outString,
+    const char *name,
+    NvU32 index,
+    const NVEvoChannel *pChannel)
+{
+    NVEvoInfoStringRec infoString;
+
+    if (pChannel == NULL) {
+        return;
+    }
+
+    nvInitInfoString(&infoString, buffer, size);
+    nvEvoLogInfoString(&infoString,
+                       " %-7s %2d  stalls: %u  total: %" NvU64_fmtu
+                       " us  max: %" NvU64_fmtu " us",
+                       name, index, pChannel->stalls.count,
+                       pChannel->stalls.totalUsec, pChannel->stalls.maxUsec);
+    outString(data, buffer);
+}
+
+static void
+ProcFsPrintPushBufferStalls(
+    void *data,
+    char *buffer,
+    size_t size,
+    nvkms_procfs_out_string_func_t *outString)
+{
+    NVDevEvoPtr pDevEvo;
+    NvU32 i;
+    NVEvoInfoStringRec infoString;
+
+    FOR_ALL_EVO_DEVS(pDevEvo) {
+
+        nvInitInfoString(&infoString, buffer, size);
+        nvEvoLogInfoString(&infoString,
+                           "pDevEvo (deviceId:%02d)         : %p",
+                           pDevEvo->deviceId, pDevEvo);
+        outString(data, buffer);
+
+        ProcFsPrintOneChannelStalls(data, buffer, size, outString,
+                                    "core", 0, pDevEvo->core);
+
+        for (i = 0; i < ARRAY_LEN(pDevEvo->base); i++) {
+            ProcFsPrintOneChannelStalls(data, buffer, size, outString,
+                                        "base", i, pDevEvo->base[i]);
+        }
+
+        for (i = 0; i < ARRAY_LEN(pDevEvo->overlay); i++) {
+            ProcFsPrintOneChannelStalls(data, buffer, size, outString,
+                                        "overlay", i, pDevEvo->overlay[i]);
+        }
+
+        for (i = 0; i < ARRAY_LEN(pDevEvo->window); i++) {
+            ProcFsPrintOneChannelStalls(data, buffer, size, outString,
+                                        "window", i, pDevEvo->window[i]);
+        }
+    }
+}
+
+static void
+ProcFsPrintParsedEdidCache(
+    void *data,
+    char *buffer,
+    size_t size,
+    nvkms_procfs_out_string_func_t *outString)
+{
+    NVDevEvoPtr pDevEvo;
+    NVEvoInfoStringRec infoString;
+
+    FOR_ALL_EVO_DEVS(pDevEvo) {
+        NvU32 i, numEntries = 0;
+
+        for (i = 0; i < ARRAY_LEN(pDevEvo->parsedEdidCache.entries); i++) {
+            if (pDevEvo->parsedEdidCache.entries[i] != NULL) {
+                numEntries++;
+            }
+        }
+
+        nvInitInfoString(&infoString, buffer, size);
+        nvEvoLogInfoString(&infoString,
+                           "pDevEvo (deviceId:%02d)         : %p",
+                           pDevEvo->deviceId, pDevEvo);
+        outString(data, buffer);
+
+        nvInitInfoString(&infoString, buffer, size);
+        nvEvoLogInfoString(&infoString,
+                           " entries: %u/%u  hits: %u  misses: %u",
+                           numEntries,
+                           (NvU32)ARRAY_LEN(pDevEvo->parsedEdidCache.entries),
+                           pDevEvo->parsedEdidCache.hits,
+                           pDevEvo->parsedEdidCache.misses);
+        outString(data, buffer);
+    }
+}
+
 #endif /* NVKMS_PROCFS_ENABLE */
 
 void nvKmsGetProcFiles(const nvkms_procfs_file_t **ppProcFiles)
@@ -4333,6 +4524,8 @@ void nvKmsGetProcFiles(const nvkms_procfs_file_t **ppProcFiles)
         { "surfaces",               ProcFsPrintSurfaces },
         { "deferred-request-fifos", ProcFsPrintDeferredRequestFifos },
         { "crcs",                   ProcFsPrintDpyCrcs },
+        { "pushbuffer-stalls",      ProcFsPrintPushBufferStalls },
+        { "edid-cache",             ProcFsPrintParsedEdidCache },
         { NULL, NULL },
     };
 
@@ -4347,6 +4540,11 @@ static void FreeGlobalState(void)
     nvKmsClose(nvEvoGlobal.nvKmsPerOpen);
     nvEvoGlobal.nvKmsPerOpen = NULL;
 
+    if (pEventListLock != NULL) {
+        nvkms_sema_free(pEventListLock);
+        pEventListLock = NULL;
+    }
+
     if (nvEvoGlobal.clientHandle != 0) {
         nvRmApiFree(nvEvoGlobal.clientHandle, nvEvoGlobal.clientHandle,
                     nvEvoGlobal.clientHandle);
@@ -4360,6 +4558,20 @@ NvBool nvKmsModuleLoad(void)
 
     nvEvoLog(EVO_LOG_INFO, "Loading %s", pNV_KMS_ID);
 
+#if defined(DEBUG)
+    nvEvoGlobal.debugMemoryAllocationLock = nvkms_sema_alloc();
+    if (nvEvoGlobal.debugMemoryAllocationLock == NULL) {
+        nvEvoLog(EVO_LOG_ERROR, "Failed to allocate memory tracker lock");
+        goto fail;
+    }
+#endif
+
+    pEventListLock = nvkms_sema_alloc();
+    if (pEventListLock == NULL) {
+        nvEvoLog(EVO_LOG_ERROR, "Failed to allocate event list lock");
+        goto fail;
+    }
+
     ret = nvRmApiAlloc(NV01_NULL_OBJECT,
                        NV01_NULL_OBJECT,
                        NV01_NULL_OBJECT,
@@ -4385,6 +4597,12 @@ NvBool nvKmsModuleLoad(void)
     return TRUE;
 fail:
     FreeGlobalState();
+#if defined(DEBUG)
+    if (nvEvoGlobal.debugMemoryAllocationLock != NULL) {
+        nvkms_sema_free(nvEvoGlobal.debugMemoryAllocationLock);
+        nvEvoGlobal.debugMemoryAllocationLock = NULL;
+    }
+#endif
 
     return FALSE;
 }
@@ -4398,6 +4616,8 @@ void nvKmsModuleUnload(void)
     nvAssert(nvListIsEmpty(&nvEvoGlobal.devList));
 #if defined(DEBUG)
     nvReportUnfreedAllocations();
+    nvkms_sema_free(nvEvoGlobal.debugMemoryAllocationLock);
+    nvEvoGlobal.debugMemoryAllocationLock = NULL;
 #endif
     nvEvoLog(EVO_LOG_INFO, "Unloading");
 }
@@ -4415,7 +4635,10 @@ static void SendEvent(struct NvKmsPerOpen *pOpen,
     }
 
     pEntry->event = *pEvent;
+
+    nvkms_sema_down(pEventListLock);
     nvListAppend(&pEntry->eventListEntry, &pOpen->ioctl.eventList);
+    nvkms_sema_up(pEventListLock);
 
     nvkms_event_queue_changed(pOpen->pOpenKernel, TRUE);
 }
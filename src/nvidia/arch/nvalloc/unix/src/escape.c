@@ -773,6 +773,25 @@ NV_STATUS RmIoctl(
             break;
         }
 
+        case NV_ESC_RM_CONTROL_BATCH:
+        {
+            NVOS54_BATCH_PARAMETERS *pApi = data;
+
+            NV_CTL_DEVICE_ONLY(nv);
+
+            if ((dataSize < sizeof(NVOS54_BATCH_PARAMETERS)) ||
+                (pApi->numEntries > NVOS54_BATCH_MAX_ENTRIES) ||
+                (dataSize != sizeof(NVOS54_BATCH_PARAMETERS) +
+                             pApi->numEntries * sizeof(NVOS54_PARAMETERS)))
+            {
+                rmStatus = NV_ERR_INVALID_ARGUMENT;
+                goto done;
+            }
+
+            Nv04ControlBatchWithSecInfo(pApi, secInfo);
+            break;
+        }
+
         case NV_ESC_RM_UPDATE_DEVICE_MAPPING_INFO:
         {
             NVOS56_PARAMETERS *pApi = data;
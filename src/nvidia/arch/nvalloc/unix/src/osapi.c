@@ -47,6 +47,8 @@
 #include <core/locks.h>
 
 #include "rmapi/exports.h"
+#include "rmapi/rmapi.h"
+#include "rmapi/param_copy.h"
 #include "rmapi/rs_utils.h"
 #include "rmapi/resource_fwd_decls.h"
 #include <nv-kernel-rmapi-ops.h>
@@ -3612,6 +3614,50 @@ finish:
     NV_EXIT_RM_RUNTIME(sp,fp);
 }
 
+//
+// Report the RM API caches' counters for /proc/driver/nvidia/rmapi_cache.
+// The caches take their own locks, so no RM lock is needed here.
+//
+void NV_API_CALL rm_get_rmapi_cache_stats(
+    nvidia_stack_t *sp,
+    nv_rmapi_cache_stats_t *pStats
+)
+{
+    RMAPI_CONTROL_CACHE_STATS controlStats;
+    RMAPI_PARAM_COPY_CACHE_STATS paramCopyStats;
+    void *fp;
+    NvU32 i;
+
+    ct_assert(NV_RMAPI_CONTROL_CACHE_STATS_CMDS == RMAPI_CONTROL_CACHE_STATS_CMDS);
+
+    NV_ENTER_RM_RUNTIME(sp,fp);
+
+    // Counters of a disabled cache read as zero.
+    rmapiControlCacheGetStats(&controlStats);
+    pStats->control_cache_hits        = controlStats.hits;
+    pStats->control_cache_misses      = controlStats.misses;
+    pStats->control_cache_evictions   = controlStats.evictions;
+    pStats->control_cache_num_cmds    = controlStats.numCmds;
+    for (i = 0; i < controlStats.numCmds; i++)
+    {
+        pStats->control_cache_cmds[i].cmd       = controlStats.cmds[i].cmd;
+        pStats->control_cache_cmds[i].hits      = controlStats.cmds[i].hits;
+        pStats->control_cache_cmds[i].misses    = controlStats.cmds[i].misses;
+        pStats->control_cache_cmds[i].evictions = controlStats.cmds[i].evictions;
+    }
+    pStats->control_cache_other.cmd       = 0;
+    pStats->control_cache_other.hits      = controlStats.other.hits;
+    pStats->control_cache_other.misses    = controlStats.other.misses;
+    pStats->control_cache_other.evictions = controlStats.other.evictions;
+
+    rmapiParamsCacheGetStats(&paramCopyStats);
+    pStats->param_copy_cache_hits     = paramCopyStats.hits;
+    pStats->param_copy_cache_misses   = paramCopyStats.misses;
+    pStats->param_copy_cache_uncached = paramCopyStats.uncached;
+
+    NV_EXIT_RM_RUNTIME(sp,fp);
+}
+
 //
 // disable GPU SW state persistence
 //
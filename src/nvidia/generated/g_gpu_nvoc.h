@@ -599,13 +599,22 @@ typedef struct engine_event_node
     PEVENTNOTIFICATION pEventNotify;
     struct Memory *pMemory;
     struct engine_event_node *pNext;
+    // Next node in the same ENGINE_EVENT_LIST::pEventBucket chain
+    struct engine_event_node *pBucketNext;
 } ENGINE_EVENT_NODE;
 
+// Number of hEvent hash buckets per engine; must be a power of 2
+#define ENGINE_EVENT_HASH_SIZE 16
+#define ENGINE_EVENT_HASH(hEvent) \
+    (((hEvent) ^ ((hEvent) >> 16)) & (ENGINE_EVENT_HASH_SIZE - 1))
+
 // Linked list of per engine non-stall event nodes
 typedef struct
 {
     ENGINE_EVENT_NODE *pEventNode;
-    // lock to protect above list
+    // The same nodes, chained by ENGINE_EVENT_HASH(hEvent) for targeted notifies
+    ENGINE_EVENT_NODE *pEventBucket[ENGINE_EVENT_HASH_SIZE];
+    // lock to protect above lists
     PORT_SPINLOCK *pSpinlock;
 } ENGINE_EVENT_LIST;
 
@@ -90,6 +90,7 @@ struct RS_LOCK_INFO
     NvU32 gpuMask;
     NvU8  traceOp;                  ///< RS_LOCK_TRACE_* operation for lock-metering
     NvU32 traceClassId;             ///< Class of initial resource that was locked for lock metering
+    NvU32 clientListLockAcquireCount; ///< Times RsServer::pClientListLock was taken on behalf of this call
 };
 
 struct RS_RES_ALLOC_PARAMS_INTERNAL
@@ -62,6 +62,35 @@ struct CLIENT_ENTRY
 #endif
 };
 
+/**
+ * RS_CLIENT_INDEX_HASH table of pClientSortedList nodes, keyed by hClient.
+ * The slot array follows the structure in the same allocation.
+ */
+struct RS_CLIENT_HASH_TABLE
+{
+    NvU32                   size;         ///< Number of slots, always a power of 2
+    CLIENT_ENTRY         ***pppSlots;
+};
+
+/**
+ * RS_CLIENT_INDEX_HASH lookup counters, one cache line per stripe.  Lookups
+ * register in count[epoch & 1] of their thread's stripe; a writer flips the
+ * epoch and waits for the previous parity to drain before freeing anything a
+ * lookup could still be reading.
+ *
+ * Each stripe is padded to RS_CLIENT_INDEX_CACHE_LINE_SIZE and the stripe
+ * array is allocated aligned to it (PORT_ALLOC only guarantees pointer
+ * alignment), so stripes never share a cache line.
+ */
+#define RS_CLIENT_INDEX_READER_STRIPES 16
+#define RS_CLIENT_INDEX_CACHE_LINE_SIZE 64
+
+struct RS_CLIENT_INDEX_READERS
+{
+    volatile NvU32          count[2];
+    NvU32                   padding[14];
+};
+
 /**
  * Base-class for objects that are shared among multiple
  * RsResources (including RsResources from other clients)
@@ -248,10 +277,19 @@ struct RsServer
     RsClientList             *pClientSortedList; ///< Bucket if linked List of clients (and their locks) owned by this server
     NvU32                     clientCurrentHandleIndex;
 
+    RS_CLIENT_INDEX_TYPE      clientIndexType; ///< How client handles are looked up in pClientSortedList
+    RS_CLIENT_HASH_TABLE     *pClientHashTable; ///< RS_CLIENT_INDEX_HASH: open-addressed table of pClientSortedList nodes
+    NvU32                     clientHashCount; ///< Number of occupied slots in pClientHashTable
+    volatile NvU32            clientIndexSeq; ///< Odd while a writer is modifying pClientHashTable
+    volatile NvU32            clientIndexEpoch; ///< Selects the lookup counters new lookups register in
+    RS_CLIENT_INDEX_READERS  *pClientIndexReaders; ///< RS_CLIENT_INDEX_HASH: RS_CLIENT_INDEX_READER_STRIPES lookup counters, cache line aligned
+    void                     *pClientIndexReadersAlloc; ///< Allocation backing pClientIndexReaders
+
     NvBool                    bConstructed; ///< Determines whether the server is ready to be used
     PORT_MEM_ALLOCATOR       *pAllocator; ///< Allocator to use for all objects allocated by the server
+    PORT_MEM_ALLOCATOR       *pRefAllocator; ///< Small object cache for resource reference maps and lists, or pAllocator
 
-    PORT_RWLOCK              *pClientListLock; ///< Lock that needs to be taken when accessing the client list
+    PORT_RWLOCK              *pClientListLock; ///< Lock that needs to be taken when modifying the client list
 
     PORT_SPINLOCK            *pShareMapLock; ///< Lock that needs to be taken when accessing the shared resource map
     RsSharedMap               shareMap; ///< Map of shared resources
@@ -302,8 +340,9 @@ struct RsServer
  * @param[in]   pServer This server instance
  * @param[in]   privilegeLevel Privilege level for this resource server instance
  * @param[in]   maxDomains Maximum number of domains to support, or 0 for the default
+ * @param[in]   clientIndexType How client handles are indexed for lookup and allocation
  */
-NV_STATUS serverConstruct(RsServer *pServer, RS_PRIV_LEVEL privilegeLevel, NvU32 maxDomains);
+NV_STATUS serverConstruct(RsServer *pServer, RS_PRIV_LEVEL privilegeLevel, NvU32 maxDomains, RS_CLIENT_INDEX_TYPE clientIndexType);
 
 /**
  * Destroy a server instance. Destructing a server does not guarantee that child domains
@@ -127,6 +127,7 @@ void        Nv04AllocWithSecInfo                  (NVOS21_PARAMETERS*, API_SECUR
 void        Nv04AllocWithAccessSecInfo            (NVOS64_PARAMETERS*, API_SECURITY_INFO);
 void        Nv01FreeWithSecInfo                   (NVOS00_PARAMETERS*, API_SECURITY_INFO);
 void        Nv04ControlWithSecInfo                (NVOS54_PARAMETERS*, API_SECURITY_INFO);
+void        Nv04ControlBatchWithSecInfo           (NVOS54_BATCH_PARAMETERS*, API_SECURITY_INFO);
 void        Nv04VidHeapControlWithSecInfo         (NVOS32_PARAMETERS*, API_SECURITY_INFO);
 void        Nv01ConfigGetWithSecInfo              (NVOS13_PARAMETERS*, API_SECURITY_INFO);
 void        Nv01ConfigSetWithSecInfo              (NVOS14_PARAMETERS*, API_SECURITY_INFO);
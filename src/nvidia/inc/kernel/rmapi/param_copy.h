@@ -96,4 +96,22 @@ NV_STATUS rmapiParamsCopyIn(const char *msgTag, void *pKernelParams, NvP64 pUser
 // Init copy_param structure
 NV_STATUS rmapiParamsCopyInit(RMAPI_PARAM_COPY *, NvU32 hClass);
 
+//
+// Copy-in buffers up to this size are recycled through a size-classed cache
+// rather than allocated and freed on every call.
+//
+#define RMAPI_PARAM_COPY_CACHE_MAX_SIZE               (4*1024)
+
+typedef struct
+{
+    NvU64 hits;         // cacheable buffers served from the cache
+    NvU64 misses;       // cacheable buffers that had to be allocated
+    NvU64 uncached;     // buffers above RMAPI_PARAM_COPY_CACHE_MAX_SIZE
+} RMAPI_PARAM_COPY_CACHE_STATS;
+
+void rmapiParamsCacheInit(void);
+void rmapiParamsCacheDestroy(void);
+// Reported in /proc/driver/nvidia/rmapi_cache on Linux
+void rmapiParamsCacheGetStats(RMAPI_PARAM_COPY_CACHE_STATS *pStats);
+
 #endif // _PARAM_COPY_H_
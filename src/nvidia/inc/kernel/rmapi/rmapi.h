@@ -259,12 +259,43 @@ NV_STATUS RmConfigSetEx   (NvHandle, NvHandle, NvU32, NvP64, NvU32, NvBool);
 /**
  * Control cache API.
  * Every function except rmapiControlCacheInit and rmapiControlCacheFree is thread safe.
+ *
+ * The cache is bounded by the RmCacheableControlsMaxSize registry key and evicts
+ * least recently used entries. rmapiControlCacheGet copies a cached result into
+ * params and returns NV_ERR_OBJECT_NOT_FOUND on a miss.
+ *
+ * rmapiControlCacheGetStats returns hit, miss and eviction counts for each
+ * control and their totals; they are reported in /proc/driver/nvidia/rmapi_cache
+ * on Linux. Only the first RMAPI_CONTROL_CACHE_STATS_CMDS controls seen get
+ * their own counters, the rest are counted together in other.
  */
+#define RMAPI_CONTROL_CACHE_STATS_CMDS 16
+
+typedef struct
+{
+    NvU32 cmd;
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 evictions;
+} RMAPI_CONTROL_CACHE_CMD_STATS;
+
+typedef struct
+{
+    NvU64 hits;
+    NvU64 misses;
+    NvU64 evictions;
+    NvU32 numCmds;
+    RMAPI_CONTROL_CACHE_CMD_STATS cmds[RMAPI_CONTROL_CACHE_STATS_CMDS];
+    RMAPI_CONTROL_CACHE_CMD_STATS other;
+} RMAPI_CONTROL_CACHE_STATS;
+
 void rmapiControlCacheInit(void);
 NvBool rmapiControlIsCacheable(NvU32 flags, NvBool isGSPClient);
-void* rmapiControlCacheGet(NvHandle hClient, NvHandle hObject, NvU32 cmd);
+NV_STATUS rmapiControlCacheGet(NvHandle hClient, NvHandle hObject, NvU32 cmd,
+    void* params, NvU32 paramsSize);
 NV_STATUS rmapiControlCacheSet(NvHandle hClient, NvHandle hObject, NvU32 cmd,
     void* params, NvU32 paramsSize);
+NV_STATUS rmapiControlCacheGetStats(RMAPI_CONTROL_CACHE_STATS *pStats);
 void rmapiControlCacheFree(void);
 void rmapiControlCacheFreeClient(NvHandle hClient);
 void rmapiControlCacheFreeObject(NvHandle hClient, NvHandle hObject);
@@ -101,6 +101,28 @@ typedef struct {
     unsigned int sn; /* used by inflated type 0 (stored) block */
 } GZ_INFLATE_CODES_STATE, *PGZ_INFLATE_CODES_STATE;
 
+/* Maximum number of access points kept by a seek index. */
+#define GZ_INDEX_MAX_POINTS 32
+
+/* An access point is taken at a deflate block boundary: the input bit
+   position plus the full 32K slide window is all that is needed to resume
+   inflating from there.  window[0, wp) holds the not yet flushed output
+   starting at outptr, the remainder is the back-reference history. */
+typedef struct {
+    NvU32 outptr;                   /* output offset of window[0] */
+    NvU32 inptr;                    /* input position */
+    ulg bb;                         /* bit buffer */
+    unsigned int bk;                /* bits in bit buffer */
+    unsigned int wp;                /* current position in slide */
+    uch *window;                    /* saved copy of the slide window */
+} GZ_INFLATE_POINT, *PGZ_INFLATE_POINT;
+
+typedef struct {
+    NvU32 spacing;                  /* minimum output distance between points */
+    NvU32 count;                    /* number of valid points */
+    GZ_INFLATE_POINT points[GZ_INDEX_MAX_POINTS];
+} GZ_INFLATE_INDEX, *PGZ_INFLATE_INDEX;
+
 typedef struct {
     struct huft *tl;      /* literal/length code table */
     struct huft *td;      /* distance code table */
@@ -124,11 +146,14 @@ typedef struct {
     NvU32 optSize;
     GZ_INFLATE_CODES_STATE codesState;
 
+    PGZ_INFLATE_INDEX pIndex;       /* optional seek index, may be NULL */
+
 } GZ_INFLATE_STATE, *PGZ_INFLATE_STATE;
 
 NV_STATUS utilGzIterator(PGZ_INFLATE_STATE pGzState);
 NV_STATUS utilGzAllocate(const NvU8 *zArray, NvU32 numTotalBytes, PGZ_INFLATE_STATE *ppGzState);
 NvU32 utilGzGetData(PGZ_INFLATE_STATE pGzState, NvU32 offset, NvU32 size, NvU8 * outBuffer);
 NV_STATUS utilGzDestroy(PGZ_INFLATE_STATE pGzState);
+NV_STATUS utilGzIndexCreate(PGZ_INFLATE_STATE pGzState, NvU32 spacing);
 
 #endif
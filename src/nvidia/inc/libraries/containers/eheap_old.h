@@ -36,6 +36,34 @@
 typedef struct OBJEHEAP *POBJEHEAP;
 typedef struct OBJEHEAP OBJEHEAP;
 
+//
+// Free block selection policy, fixed at construction time.
+//
+// LINEAR walks the address ordered free list and takes the lowest (or
+// highest, for NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN) block that fits.
+//
+// The other policies additionally keep the free blocks in power of two size
+// classes, so blocks too small for a request are never visited:
+//
+// ADDRESS_FIRST_FIT picks the same block LINEAR would: the lowest (highest
+// for GROWS_DOWN) addressed block that fits.  The class lists are not kept
+// in address order, so every block in the eligible classes is visited; it
+// only beats LINEAR when most free blocks are smaller than the request.
+//
+// BEST_FIT picks the smallest block that fits, preferring the lowest (highest
+// for GROWS_DOWN) address among blocks of that size.
+//
+// Fixed address and internal index requests always use the address list.
+//
+typedef enum
+{
+    EHEAP_ALLOC_POLICY_LINEAR = 0,
+    EHEAP_ALLOC_POLICY_ADDRESS_FIRST_FIT,
+    EHEAP_ALLOC_POLICY_BEST_FIT,
+} EHEAP_ALLOC_POLICY;
+
+#define EHEAP_NUM_SIZE_CLASSES 64
+
 typedef struct EMEMBLOCK *PEMEMBLOCK;
 typedef struct EMEMBLOCK
 {
@@ -48,6 +76,8 @@ typedef struct EMEMBLOCK
     NODE       node;
     PEMEMBLOCK prevFree;
     PEMEMBLOCK nextFree;
+    PEMEMBLOCK prevSizeFree;      // size class list, indexed policies only
+    PEMEMBLOCK nextSizeFree;
     PEMEMBLOCK prev;
     PEMEMBLOCK next;
     void      *pData;
@@ -109,8 +139,11 @@ struct OBJEHEAP
     NvU32      numPreAllocMemStruct;
     PEMEMBLOCK pFreeMemStructList;
     PEMEMBLOCK pPreAllocAddr;
+    EHEAP_ALLOC_POLICY allocPolicy;
+    PEMEMBLOCK *pSizeClassList;   // EHEAP_NUM_SIZE_CLASSES entries, indexed policies only
 };
 
 extern void constructObjEHeap(POBJEHEAP, NvU64, NvU64, NvU32, NvU32);
+extern void constructObjEHeapWithPolicy(POBJEHEAP, NvU64, NvU64, NvU32, NvU32, EHEAP_ALLOC_POLICY);
 
 #endif // _EHEAP_H_
@@ -56,6 +56,9 @@ Dynamic *__nvoc_dynamicCastById(Dynamic *pFromObj, NVOC_CLASS_ID classId);
 
 void __nvoc_destructFromBase(Dynamic *pDynamic);
 
+void __nvoc_lookupCacheInit(void);
+void __nvoc_lookupCacheDestroy(void);
+
 Dynamic *fullyDeriveWrapper(Dynamic *pDynamic);
 
 extern const NVOC_RTTI_PROVIDER __nvoc_rtti_provider;
@@ -112,6 +112,9 @@ void *portMemAllocPaged_CallerInfo(NvLength, PORT_MEM_CALLERINFO);
 void *portMemAllocNonPaged_CallerInfo(NvLength, PORT_MEM_CALLERINFO);
 PORT_MEM_ALLOCATOR *portMemAllocatorCreatePaged_CallerInfo(PORT_MEM_CALLERINFO);
 PORT_MEM_ALLOCATOR *portMemAllocatorCreateNonPaged_CallerInfo(PORT_MEM_CALLERINFO);
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+PORT_MEM_ALLOCATOR *portMemExAllocatorCreateObjectCache_CallerInfo(PORT_MEM_CALLERINFO);
+#endif //portMemExAllocatorCreateObjectCache_SUPPORTED
 void portMemInitializeAllocatorTracking_CallerInfo(PORT_MEM_ALLOCATOR *, PORT_MEM_ALLOCATOR_TRACKING *, PORT_MEM_CALLERINFO);
 void *_portMemAllocatorAlloc_CallerInfo(PORT_MEM_ALLOCATOR*, NvLength, PORT_MEM_CALLERINFO);
 PORT_MEM_ALLOCATOR *portMemAllocatorCreateOnExistingBlock_CallerInfo(void *, NvLength, PORT_MEM_CALLERINFO);
@@ -130,6 +133,10 @@ PORT_MEM_ALLOCATOR *portMemExAllocatorCreateLockedOnExistingBlock_CallerInfo(voi
     portMemAllocatorCreatePaged_CallerInfo(PORT_MEM_CALLERINFO_MAKE)
 #define portMemAllocatorCreateNonPaged()                                       \
     portMemAllocatorCreateNonPaged_CallerInfo(PORT_MEM_CALLERINFO_MAKE)
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+#define portMemExAllocatorCreateObjectCache()                                  \
+    portMemExAllocatorCreateObjectCache_CallerInfo(PORT_MEM_CALLERINFO_MAKE)
+#endif //portMemExAllocatorCreateObjectCache_SUPPORTED
 
 #define portMemInitializeAllocatorTracking(pAlloc, pTrack)                     \
     portMemInitializeAllocatorTracking_CallerInfo(pAlloc, pTrack, PORT_MEM_CALLERINFO_MAKE)
@@ -146,9 +153,12 @@ PORT_MEM_ALLOCATOR *portMemExAllocatorCreateLockedOnExistingBlock_CallerInfo(voi
 #endif // CALLERINFO
 
 
-#if PORT_MEM_TRACK_USE_FENCEPOSTS || PORT_MEM_TRACK_USE_ALLOCLIST || PORT_MEM_TRACK_USE_CALLERINFO
+#if PORT_MEM_TRACK_USE_FENCEPOSTS || PORT_MEM_TRACK_USE_ALLOCLIST || PORT_MEM_TRACK_USE_CALLERINFO || PORT_MEM_TRACK_USE_STRIPES
 typedef struct PORT_MEM_HEADER
 {
+#if PORT_MEM_TRACK_USE_STRIPES
+                                    NvLength stripe;
+#endif
 #if PORT_MEM_TRACK_USE_CALLERINFO
                                     PORT_MEM_CALLERINFO callerInfo;
 #endif
@@ -177,12 +187,15 @@ typedef struct PORT_MEM_FOOTER
 #define PORT_MEM_STAGING_SIZE        0
 #endif
 
-struct PORT_MEM_ALLOCATOR_TRACKING
-{
-    PORT_MEM_ALLOCATOR                 *pAllocator;
-    struct PORT_MEM_ALLOCATOR_TRACKING *pPrev;
-    struct PORT_MEM_ALLOCATOR_TRACKING *pNext;
+#if PORT_MEM_TRACK_USE_STRIPES
+#define PORT_MEM_TRACK_STRIPES_LOG2 4
+#else
+#define PORT_MEM_TRACK_STRIPES_LOG2 0
+#endif
+#define PORT_MEM_TRACK_NUM_STRIPES  (1 << PORT_MEM_TRACK_STRIPES_LOG2)
 
+typedef struct PORT_MEM_TRACK_STRIPE
+{
 #if PORT_MEM_TRACK_USE_COUNTER
     PORT_MEM_COUNTER                    counter;
 #endif
@@ -190,6 +203,18 @@ struct PORT_MEM_ALLOCATOR_TRACKING
     PORT_MEM_LIST                      *pFirstAlloc;
     void                               *listLock;
 #endif
+#if !PORT_MEM_TRACK_USE_COUNTER && !PORT_MEM_TRACK_USE_ALLOCLIST
+    NvU32                               unused;
+#endif
+} PORT_MEM_TRACK_STRIPE;
+
+struct PORT_MEM_ALLOCATOR_TRACKING
+{
+    PORT_MEM_ALLOCATOR                 *pAllocator;
+    struct PORT_MEM_ALLOCATOR_TRACKING *pPrev;
+    struct PORT_MEM_ALLOCATOR_TRACKING *pNext;
+
+    PORT_MEM_TRACK_STRIPE               stripes[PORT_MEM_TRACK_NUM_STRIPES];
 #if PORT_MEM_TRACK_USE_CALLERINFO
     PORT_MEM_CALLERINFO                 callerInfo;
 #endif
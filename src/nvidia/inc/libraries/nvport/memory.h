@@ -545,6 +545,8 @@ typedef struct PORT_MEM_TRACK_ALLOCATOR_STATS
     NvLength usefulSize;
     /** @brief Extra size allocated for tracking/debugging purposes */
     NvLength metaSize;
+    /** @brief Size of freed objects held for reuse by object cache allocators */
+    NvLength cachedSize;
 } PORT_MEM_TRACK_ALLOCATOR_STATS;
 
 /**
@@ -810,6 +812,32 @@ PORT_MEM_ALLOCATOR *portMemExAllocatorCreateLockedOnExistingBlock(void *pPreallo
 #define portMemExAllocatorCreateLockedOnExistingBlock_SUPPORTED \
                             (PORT_IS_MODULE_SUPPORTED(sync))
 
+/**
+ * @brief Creates a non-paged allocator that caches small freed objects.
+ *
+ * Allocations of up to @ref PORT_MEM_OBJECT_CACHE_MAX_SIZE bytes (including
+ * tracking staging) are rounded up to a power of 2 size class. Freed objects
+ * are kept on free lists striped by the freeing thread and handed out again
+ * without going to the OS. Larger allocations behave like
+ * @ref portMemAllocNonPaged.
+ *
+ * Memory held on the free lists is reported as
+ * PORT_MEM_TRACK_ALLOCATOR_STATS::cachedSize by
+ * @ref portMemExTrackingGetActiveStats and returned to the OS when the
+ * allocator is released.
+ *
+ * @return NULL if creation failed.
+ *
+ * @pre Windows: IRQL <= DISPATCH_LEVEL
+ * @pre Unix:    Non-interrupt context
+ * @note Will not put the thread to sleep.
+ */
+PORT_MEM_ALLOCATOR *portMemExAllocatorCreateObjectCache(void);
+#define portMemExAllocatorCreateObjectCache_SUPPORTED PORT_IS_KERNEL_BUILD
+
+/// @brief Largest allocation served from the object cache size classes
+#define PORT_MEM_OBJECT_CACHE_MAX_SIZE 512
+
 
 /**
  * @brief Maps the given physical address range to nonpaged system space.
@@ -904,6 +932,18 @@ void portMemExUnmapIOSpace(void *addr, NvU64 byteSize);
  */
 #define PORT_MEM_TRACK_USE_LOGGING 0
 #endif
+#if !defined(PORT_MEM_TRACK_USE_STRIPES)
+/**
+ * @brief Split counters and allocation lists into stripes
+ *
+ * Each allocation is accounted in a stripe selected by the allocating thread,
+ * so concurrent allocations do not contend on shared counters or list locks.
+ * Stats are aggregated on query; peak stats become the sum of per-stripe
+ * peaks, which is an upper bound of the real peak.
+ * Default is off.
+ */
+#define PORT_MEM_TRACK_USE_STRIPES 0
+#endif
 
 /** @brief Nothing is printed unless @ref portMemPrintTrackingInfo is called */
 #define PORT_MEM_TRACK_PRINT_LEVEL_SILENT  0
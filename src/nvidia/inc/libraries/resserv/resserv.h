@@ -62,6 +62,8 @@ extern int g_debugLevel;
 typedef struct RsServer RsServer;
 typedef struct RsDomain RsDomain;
 typedef struct CLIENT_ENTRY CLIENT_ENTRY;
+typedef struct RS_CLIENT_HASH_TABLE RS_CLIENT_HASH_TABLE;
+typedef struct RS_CLIENT_INDEX_READERS RS_CLIENT_INDEX_READERS;
 typedef struct RsResourceDep RsResourceDep;
 typedef struct RsResourceRef RsResourceRef;
 typedef struct RsInterMapping RsInterMapping;
@@ -155,6 +157,19 @@ typedef void *PUID_TOKEN;
 #define RS_CLIENT_HANDLE_BUCKET_COUNT   0x400  // 1024
 #define RS_CLIENT_HANDLE_BUCKET_MASK    0x3FF
 
+/// How RsServer indexes its CLIENT_ENTRYs by handle, chosen at serverConstruct
+typedef enum
+{
+    /// Per-bucket lists kept sorted by handle; lookups walk the bucket
+    RS_CLIENT_INDEX_SORTED_LIST = 0,
+    /// Open-addressed hash over hClient; lookups, inserts and removals are O(1)
+    /// and lookups only take pClientListLock when writers keep racing them
+    RS_CLIENT_INDEX_HASH,
+} RS_CLIENT_INDEX_TYPE;
+
+/// Initial number of slots in the RS_CLIENT_INDEX_HASH table, must be a power of 2
+#define RS_CLIENT_HASH_INITIAL_SIZE     0x400
+
 
 /// The default maximum number of domains a resource server can allocate
 #define RS_MAX_DOMAINS_DEFAULT          4096
@@ -345,6 +345,13 @@
 #define NV_REG_STR_RM_CACHEABLE_CONTROLS_GSP_ONLY    1
 #define NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE      2
 
+// Maximum size in bytes of cached control results, including bookkeeping.
+// Least recently used results are evicted once the limit is reached.
+// 0: unbounded
+// Default: 4MB
+#define NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_SIZE            "RmCacheableControlsMaxSize"
+#define NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_SIZE_DEFAULT    (4 * 1024 * 1024)
+
 
 // Enable backtrace dumping at assertion failure.
 // If physical RM or RCDB is unavailable, then this regkey controls the behaviour of backtrace
@@ -404,6 +404,9 @@ coreInitializeRm(void)
     // Required before any NvLog (NV_PRINTF) calls
     NVLOG_INIT(NULL);
 
+    // NVOC cast and exported method lookup tables
+    __nvoc_lookupCacheInit();
+
     // Required before any NV_PRINTF() calls
     if (!DBG_INIT())
     {
@@ -434,6 +437,8 @@ coreShutdownRm(void)
     //
     // Deinitalize libraries used by RM
     //
+    __nvoc_lookupCacheDestroy();
+
     nvAssertDestroy();
 
     DBG_DESTROY();
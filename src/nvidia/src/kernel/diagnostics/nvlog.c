@@ -569,16 +569,39 @@ nvlogRingBufferPush
     NvU32 oldPos;
     NvU32 lock = DRF_VAL(LOG, _BUFFER_FLAGS, _LOCKING, pBuffer->flags);
 
-    if (lock != NVLOG_BUFFER_FLAGS_LOCKING_NONE)
-        portSyncSpinlockAcquire(NvLogLogger.mainLock);
+    if (lock == NVLOG_BUFFER_FLAGS_LOCKING_LOCKFREE)
+    {
+        NvU32 newPos;
+        NvU32 wraps;
+
+        //
+        // Reserve [oldPos, oldPos + dataSize) by swapping in the new position.
+        // Each writer owns its reserved range, so the copy below needs no lock.
+        // The overflow count is bumped separately and may briefly lag pos.
+        //
+        do
+        {
+            oldPos = pBuffer->pos;
+            newPos = (NvU32)(((NvU64)oldPos + dataSize) % pBuffer->size);
+        } while (!portAtomicCompareAndSwapU32((volatile NvU32 *)&pBuffer->pos, newPos, oldPos));
+
+        wraps = (NvU32)(((NvU64)oldPos + dataSize) / pBuffer->size);
+        if (wraps != 0)
+            portAtomicAddU32((volatile NvU32 *)&pBuffer->extra.ring.overflow, wraps);
+    }
+    else
+    {
+        if (lock != NVLOG_BUFFER_FLAGS_LOCKING_NONE)
+            portSyncSpinlockAcquire(NvLogLogger.mainLock);
 
-    oldPos = pBuffer->pos;
-    pBuffer->extra.ring.overflow += (pBuffer->pos + dataSize) / pBuffer->size;
-    pBuffer->pos                  = (pBuffer->pos + dataSize) % pBuffer->size;
+        oldPos = pBuffer->pos;
+        pBuffer->extra.ring.overflow += (pBuffer->pos + dataSize) / pBuffer->size;
+        pBuffer->pos                  = (pBuffer->pos + dataSize) % pBuffer->size;
 
-    // State locking does portMemCopy unlocked.
-    if (lock == NVLOG_BUFFER_FLAGS_LOCKING_STATE)
-        portSyncSpinlockRelease(NvLogLogger.mainLock);
+        // State locking does portMemCopy unlocked.
+        if (lock == NVLOG_BUFFER_FLAGS_LOCKING_STATE)
+            portSyncSpinlockRelease(NvLogLogger.mainLock);
+    }
 
     while (dataSize > 0)
     {
@@ -668,15 +691,29 @@ nvlogNowrapBufferPush
         }
     }
 
-    if (lock != NVLOG_BUFFER_FLAGS_LOCKING_NONE)
-        portSyncSpinlockAcquire(NvLogLogger.mainLock);
+    if (lock == NVLOG_BUFFER_FLAGS_LOCKING_LOCKFREE)
+    {
+        // Another writer may have taken the remaining space since the check above.
+        do
+        {
+            oldPos = pBuffer->pos;
+            if (oldPos + dataSize >= pBuffer->size)
+                return NV_FALSE;
+        } while (!portAtomicCompareAndSwapU32((volatile NvU32 *)&pBuffer->pos,
+                                              oldPos + dataSize, oldPos));
+    }
+    else
+    {
+        if (lock != NVLOG_BUFFER_FLAGS_LOCKING_NONE)
+            portSyncSpinlockAcquire(NvLogLogger.mainLock);
 
-      oldPos = pBuffer->pos;
-      pBuffer->pos = oldPos + dataSize;
+          oldPos = pBuffer->pos;
+          pBuffer->pos = oldPos + dataSize;
 
-    // State locking does portMemCopy unlocked.
-    if (lock == NVLOG_BUFFER_FLAGS_LOCKING_STATE)
-        portSyncSpinlockRelease(NvLogLogger.mainLock);
+        // State locking does portMemCopy unlocked.
+        if (lock == NVLOG_BUFFER_FLAGS_LOCKING_STATE)
+            portSyncSpinlockRelease(NvLogLogger.mainLock);
+    }
 
     portMemCopy(&pBuffer->data[oldPos], dataSize, pData, dataSize);
 
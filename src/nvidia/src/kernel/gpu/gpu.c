@@ -2935,6 +2935,8 @@ NV_STATUS gpuConstructEngineTable_IMPL
     for (engineId = 0; engineId < NV2080_ENGINE_TYPE_LAST; engineId++)
     {
         pGpu->engineNonstallIntr[engineId].pEventNode = NULL;
+        portMemSet(pGpu->engineNonstallIntr[engineId].pEventBucket, 0,
+                   sizeof(pGpu->engineNonstallIntr[engineId].pEventBucket));
         pGpu->engineNonstallIntr[engineId].pSpinlock = portSyncSpinlockCreate(portMemAllocatorGetGlobalNonPaged());
         if (pGpu->engineNonstallIntr[engineId].pSpinlock == NULL)
             return NV_ERR_INSUFFICIENT_RESOURCES;
@@ -332,7 +332,7 @@ static NvBool _rmapiRmControlCanBeBypassLock(NvU32 cmd)
 }
 
 static NV_STATUS
-_rmapiRmControl(NvHandle hClient, NvHandle hObject, NvU32 cmd, NvP64 pUserParams, NvU32 paramsSize, NvU32 flags, RM_API *pRmApi, API_SECURITY_INFO *pSecInfo)
+_rmapiRmControl(NvHandle hClient, NvHandle hObject, NvU32 cmd, NvP64 pUserParams, NvU32 paramsSize, NvU32 flags, RM_API *pRmApi, API_SECURITY_INFO *pSecInfo, NvBool bApiLockHeld)
 {
     OBJSYS    *pSys = SYS_GET_INSTANCE();
     RmClient *pClient;
@@ -456,7 +456,11 @@ _rmapiRmControl(NvHandle hClient, NvHandle hObject, NvU32 cmd, NvP64 pUserParams
     rmCtrlParams.pCookie = &rmCtrlExecuteCookie;
     rmCtrlParams.bInternal = bInternalRequest;
 
-    if (pRmApi->bApiLockInternal)
+    //
+    // A batch caller holds the API lock on behalf of an external client; skip
+    // the lock without treating the request as internal.
+    //
+    if (pRmApi->bApiLockInternal || bApiLockHeld)
     {
         lockInfo.state |= RM_LOCK_STATES_API_LOCK_ACQUIRED;
         lockInfo.flags |= RM_LOCK_FLAGS_NO_API_LOCK;
@@ -780,7 +784,7 @@ rmapiControlWithSecInfo
 
     NVRM_TRACE_API('CTRL', hClient, hObject, cmd);
 
-    status = _rmapiRmControl(hClient, hObject, cmd, pParams, paramsSize, flags, pRmApi, pSecInfo);
+    status = _rmapiRmControl(hClient, hObject, cmd, pParams, paramsSize, flags, pRmApi, pSecInfo, NV_FALSE);
 
     if (status == NV_OK)
     {
@@ -879,3 +883,158 @@ rmapiControlWithSecInfoTls
     return status;
 }
 
+//
+// Returns NV_TRUE if every entry of a batch is declared with
+// RMCTRL_FLAGS_API_LOCK_READONLY and may therefore run under a read-only API
+// lock.  Entries that will be rejected anyway do not count; any entry whose
+// control cannot be resolved forces a write lock.
+//
+// The API lock must be held.
+//
+static NvBool
+_rmapiControlBatchIsApiLockReadOnly
+(
+    NvHandle           hClient,
+    NVOS54_PARAMETERS *pEntries,
+    NvU32              numEntries
+)
+{
+    RmClient *pClient;
+    NvBool    bReadOnly = NV_TRUE;
+    NvU32     i;
+
+    if (serverutilAcquireClient(hClient, LOCK_ACCESS_READ, &pClient) != NV_OK)
+        return NV_FALSE;
+
+    for (i = 0; i < numEntries; i++)
+    {
+        NVOS54_PARAMETERS *pEntry = &pEntries[i];
+        const struct NVOC_EXPORTED_METHOD_DEF *pMethod;
+        RsResourceRef *pResourceRef;
+
+        if ((pEntry->hClient != hClient) ||
+            (pEntry->flags != NVOS54_FLAGS_NONE) ||
+            RMCTRL_IS_NULL_CMD(pEntry->cmd))
+        {
+            continue;
+        }
+
+        if ((clientGetResourceRef(staticCast(pClient, RsClient), pEntry->hObject,
+                                  &pResourceRef) != NV_OK) ||
+            (pResourceRef->pResource == NULL))
+        {
+            bReadOnly = NV_FALSE;
+            break;
+        }
+
+        pMethod = objGetExportedMethodDef(staticCast(objFullyDerive(pResourceRef->pResource), Dynamic),
+                                          pEntry->cmd);
+        if ((pMethod == NULL) || !(pMethod->flags & RMCTRL_FLAGS_API_LOCK_READONLY))
+        {
+            bReadOnly = NV_FALSE;
+            break;
+        }
+    }
+
+    serverutilReleaseClient(LOCK_ACCESS_READ, pClient);
+
+    return bReadOnly;
+}
+
+//
+// Execute a batch of controls against one client under a single API lock
+// acquisition.  Each entry gets its own status; the return value only covers
+// the batch itself (argument validation and lock acquisition).
+//
+// The API lock is taken for read when the server allows read-only control
+// locking and every entry's control permits it, and for write otherwise.
+//
+// Lock bypass and raised IRQL entries are rejected, since those modes cannot
+// run behind the API lock.
+//
+NV_STATUS
+rmapiControlBatchWithSecInfo
+(
+    NvHandle           hClient,
+    NVOS54_PARAMETERS *pEntries,
+    NvU32              numEntries,
+    API_SECURITY_INFO *pSecInfo
+)
+{
+    RM_API             *pRmApi = rmapiGetInterface(RMAPI_EXTERNAL);
+    THREAD_STATE_NODE   threadState;
+    NV_STATUS           status;
+    NvU32               i;
+
+    if ((pEntries == NULL) || (numEntries == 0) ||
+        (numEntries > NVOS54_BATCH_MAX_ENTRIES))
+    {
+        return NV_ERR_INVALID_ARGUMENT;
+    }
+
+    if (!portMemExSafeForNonPagedAlloc())
+        return NV_ERR_INVALID_STATE;
+
+    threadStateInit(&threadState, THREAD_STATE_FLAGS_NONE);
+
+    // LOCK: acquire API lock, for read if the whole batch allows it
+    if (serverSupportsReadOnlyLock(&g_resServ, RS_LOCK_TOP, RS_API_CTRL))
+    {
+        status = rmapiLockAcquire(RMAPI_LOCK_FLAGS_READ, RM_LOCK_MODULES_CLIENT);
+        if ((status == NV_OK) &&
+            !_rmapiControlBatchIsApiLockReadOnly(hClient, pEntries, numEntries))
+        {
+            rmapiLockRelease();
+            status = rmapiLockAcquire(RMAPI_LOCK_FLAGS_NONE, RM_LOCK_MODULES_CLIENT);
+        }
+    }
+    else
+    {
+        status = rmapiLockAcquire(RMAPI_LOCK_FLAGS_NONE, RM_LOCK_MODULES_CLIENT);
+    }
+
+    if (status == NV_OK)
+    {
+        for (i = 0; i < numEntries; i++)
+        {
+            NVOS54_PARAMETERS *pEntry = &pEntries[i];
+
+            NVRM_TRACE_API('CTRL', hClient, pEntry->hObject, pEntry->cmd);
+
+            if ((pEntry->hClient != hClient) ||
+                (pEntry->flags != NVOS54_FLAGS_NONE))
+            {
+                pEntry->status = NV_ERR_INVALID_ARGUMENT;
+            }
+            else
+            {
+                pEntry->status = _rmapiRmControl(hClient, pEntry->hObject, pEntry->cmd,
+                                                 pEntry->params, pEntry->paramsSize,
+                                                 pEntry->flags, pRmApi, pSecInfo, NV_TRUE);
+            }
+
+            if (pEntry->status == NV_OK)
+            {
+                NVRM_TRACE('ctrl');
+            }
+            else
+            {
+                NV_PRINTF(LEVEL_INFO,
+                          "Nv04Control: batch entry %u failed; status: %s (0x%08x)\n",
+                          i, nvstatusToString(pEntry->status), pEntry->status);
+                NV_PRINTF(LEVEL_INFO,
+                          "Nv04Control:  hClient:0x%x hObject:0x%x cmd:0x%x params:" NvP64_fmt " paramSize:0x%x flags:0x%x\n",
+                          pEntry->hClient, pEntry->hObject, pEntry->cmd, pEntry->params,
+                          pEntry->paramsSize, pEntry->flags);
+                NVRM_TRACE_ERROR('ctrl', pEntry->status);
+            }
+        }
+
+        // UNLOCK: release API lock
+        rmapiLockRelease();
+    }
+
+    threadStateFree(&threadState, THREAD_STATE_FLAGS_NONE);
+
+    return status;
+}
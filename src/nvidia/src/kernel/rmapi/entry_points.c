@@ -60,6 +60,7 @@ static void _nv04VidHeapControl(NVOS32_PARAMETERS *pArgs, NvBool bUserModeArgs)
 static void _nv04AllocWithSecInfo(NVOS21_PARAMETERS*, API_SECURITY_INFO);
 static void _nv04AllocWithAccessSecInfo(NVOS64_PARAMETERS*, API_SECURITY_INFO);
 static void _nv04ControlWithSecInfo(NVOS54_PARAMETERS*, API_SECURITY_INFO, NvBool bInternalCall);
+static void _nv04ControlBatchWithSecInfo(NVOS54_BATCH_PARAMETERS*, API_SECURITY_INFO);
 static void _nv01FreeWithSecInfo(NVOS00_PARAMETERS*, API_SECURITY_INFO);
 static void _nv04AllocWithAccess(NVOS64_PARAMETERS*, NvBool);
 static void _nv04MapMemoryWithSecInfo(NVOS33_PARAMETERS*, API_SECURITY_INFO);
@@ -185,6 +186,7 @@ void Nv04AllocWithSecInfo(NVOS21_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)
 void Nv04AllocWithAccessSecInfo(NVOS64_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)         { _nv04AllocWithAccessSecInfo(pArgs, secInfo); }
 void Nv01FreeWithSecInfo(NVOS00_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)                { _nv01FreeWithSecInfo(pArgs, secInfo); }
 void Nv04ControlWithSecInfo(NVOS54_PARAMETERS  *pArgs, API_SECURITY_INFO secInfo)            { _nv04ControlWithSecInfo(pArgs, secInfo, NV_FALSE); }
+void Nv04ControlBatchWithSecInfo(NVOS54_BATCH_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)  { _nv04ControlBatchWithSecInfo(pArgs, secInfo); }
 void Nv04VidHeapControlWithSecInfo(NVOS32_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)      { RMAPI_DEPRECATED_WITH_SECINFO(RmDeprecatedVidHeapControl, pArgs, secInfo); }
 void Nv04IdleChannelsWithSecInfo(NVOS30_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)        { RMAPI_DEPRECATED_WITH_SECINFO(RmDeprecatedIdleChannels, pArgs, secInfo); }
 void Nv04MapMemoryWithSecInfo(NVOS33_PARAMETERS *pArgs, API_SECURITY_INFO secInfo)           { _nv04MapMemoryWithSecInfo(pArgs, secInfo); }
@@ -537,6 +539,32 @@ static void _nv04ControlWithSecInfo
     }
 } // end of Nv04Control()
 
+/*
+NV04_CONTROL_BATCH
+    NVOS54_BATCH_PARAMETERS:
+        NvHandle hClient;
+        NvU32    numEntries;
+        NvV32    status;
+        NvU32    reserved;
+    followed by NVOS54_PARAMETERS[numEntries]
+*/
+static void _nv04ControlBatchWithSecInfo
+(
+    NVOS54_BATCH_PARAMETERS *pArgs,
+    API_SECURITY_INFO        secInfo
+)
+{
+    NVOS54_PARAMETERS *pEntries = (NVOS54_PARAMETERS *)(pArgs + 1);
+
+    if (pArgs->reserved != 0)
+    {
+        pArgs->status = NV_ERR_INVALID_ARGUMENT;
+        return;
+    }
+
+    pArgs->status = rmapiControlBatchWithSecInfo(pArgs->hClient, pEntries, pArgs->numEntries, &secInfo);
+} // end of Nv04ControlBatch()
+
 /*
 NV04_CONTROL
     NVOS54_PARAMETERS:
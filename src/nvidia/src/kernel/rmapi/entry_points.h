@@ -168,6 +168,15 @@ rmapiControlWithSecInfoTls
     API_SECURITY_INFO *pSecInfo
 );
 
+NV_STATUS
+rmapiControlBatchWithSecInfo
+(
+    NvHandle           hClient,
+    NVOS54_PARAMETERS *pEntries,
+    NvU32              numEntries,
+    API_SECURITY_INFO *pSecInfo
+);
+
 NV_STATUS
 rmapiDupObject
 (
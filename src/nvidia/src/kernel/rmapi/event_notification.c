@@ -74,6 +74,9 @@ static NV_STATUS engineNonStallEventOp
     NvBool bInsert
 )
 {
+    ENGINE_EVENT_LIST *pEventList = &pGpu->engineNonstallIntr[engineId];
+    ENGINE_EVENT_NODE **ppBucket =
+        &pEventList->pEventBucket[ENGINE_EVENT_HASH(pEventNotify->hEvent)];
     ENGINE_EVENT_NODE *pTempNode;
     NvBool bFound = NV_FALSE;
 
@@ -92,6 +95,9 @@ static NV_STATUS engineNonStallEventOp
 
         pGpu->engineNonstallIntr[engineId].pEventNode = pTempNode;
 
+        pTempNode->pBucketNext = *ppBucket;
+        *ppBucket = pTempNode;
+
         // Release engine list spinlock
         portSyncSpinlockRelease(pGpu->engineNonstallIntr[engineId].pSpinlock);
     }
@@ -114,6 +120,14 @@ static NV_STATUS engineNonStallEventOp
 
                 pTempNode = pEngNode;
                 bFound = NV_TRUE;
+
+                // Unlink from the hEvent bucket chain as well
+                while ((*ppBucket != NULL) && (*ppBucket != pEngNode))
+                    ppBucket = &(*ppBucket)->pBucketNext;
+
+                NV_ASSERT(*ppBucket == pEngNode);
+                if (*ppBucket != NULL)
+                    *ppBucket = pEngNode->pBucketNext;
                 break;
             }
             else
@@ -141,6 +155,11 @@ static NV_STATUS engineNonStallEventOp
     return NV_OK;
 }
 
+static ENGINE_EVENT_NODE *_engineEventNodeNext(ENGINE_EVENT_NODE *pNode, NvHandle hEvent)
+{
+    return hEvent ? pNode->pBucketNext : pNode->pNext;
+}
+
 static NV_STATUS _engineNonStallIntrNotifyImpl(OBJGPU *pGpu, NvU32 engineId, NvHandle hEvent)
 {
     ENGINE_EVENT_NODE *pTempHead;
@@ -156,7 +175,14 @@ static NV_STATUS _engineNonStallIntrNotifyImpl(OBJGPU *pGpu, NvU32 engineId, NvH
     //
     portSyncSpinlockAcquire(pGpu->engineNonstallIntr[engineId].pSpinlock);
 
-    pTempHead = pGpu->engineNonstallIntr[engineId].pEventNode;
+    //
+    // A targeted notify only needs to visit the nodes in hEvent's hash bucket;
+    // a broadcast notify visits every node on the engine.
+    //
+    if (hEvent)
+        pTempHead = pGpu->engineNonstallIntr[engineId].pEventBucket[ENGINE_EVENT_HASH(hEvent)];
+    else
+        pTempHead = pGpu->engineNonstallIntr[engineId].pEventNode;
     while (pTempHead)
     {
         if (!pTempHead->pEventNotify)
@@ -177,14 +203,14 @@ static NV_STATUS _engineNonStallIntrNotifyImpl(OBJGPU *pGpu, NvU32 engineId, NvH
             if (pTempKernelMapping == NULL)
             {
                 NV_PRINTF(LEVEL_ERROR, "Per-vGPU semaphore location mapping is NULL. Skipping the current node.\n");
-                pTempHead = pTempHead->pNext;
+                pTempHead = _engineEventNodeNext(pTempHead, hEvent);
                 continue;
             }
             semValue = MEM_RD32(pTempKernelMapping + (pSemMemory->vgpuNsIntr.nsSemOffset / sizeof(NvU32)));
 
             if (pSemMemory->vgpuNsIntr.nsSemValue == semValue)
             {
-                pTempHead = pTempHead->pNext;
+                pTempHead = _engineEventNodeNext(pTempHead, hEvent);
                 continue;
             }
 
@@ -202,7 +228,7 @@ static NV_STATUS _engineNonStallIntrNotifyImpl(OBJGPU *pGpu, NvU32 engineId, NvH
         }
 
     nextEvent:
-        pTempHead = pTempHead->pNext;
+        pTempHead = _engineEventNodeNext(pTempHead, hEvent);
     }
 
     portSyncSpinlockRelease(pGpu->engineNonstallIntr[engineId].pSpinlock);
@@ -28,6 +28,208 @@
 #include "rmapi/control.h"
 #include "os/os.h"
 
+//
+// Param copy buffer cache.
+//
+// Most controls carry small params, so copy-in buffers are recycled through
+// per-thread-striped free lists in power of 2 size classes instead of going
+// to the OS allocator on every call.  Buffers larger than
+// RMAPI_PARAM_COPY_CACHE_MAX_SIZE fall through to portMemAllocNonPaged.
+//
+#define RMAPI_PARAM_COPY_CACHE_MIN_SHIFT        6       // 64 bytes
+#define RMAPI_PARAM_COPY_CACHE_NUM_CLASSES      7       // up to 4KB
+#define RMAPI_PARAM_COPY_CACHE_STRIPES_LOG2     3
+#define RMAPI_PARAM_COPY_CACHE_NUM_STRIPES      (1 << RMAPI_PARAM_COPY_CACHE_STRIPES_LOG2)
+// Free buffers kept per size class in each stripe
+#define RMAPI_PARAM_COPY_CACHE_DEPTH            4
+
+#if (1 << (RMAPI_PARAM_COPY_CACHE_MIN_SHIFT + RMAPI_PARAM_COPY_CACHE_NUM_CLASSES - 1)) != RMAPI_PARAM_COPY_CACHE_MAX_SIZE
+#error "Param copy cache size classes do not match RMAPI_PARAM_COPY_CACHE_MAX_SIZE"
+#endif
+
+typedef struct
+{
+    PORT_SPINLOCK  *pLock;
+    void           *pFree[RMAPI_PARAM_COPY_CACHE_NUM_CLASSES][RMAPI_PARAM_COPY_CACHE_DEPTH];
+    NvU32           numFree[RMAPI_PARAM_COPY_CACHE_NUM_CLASSES];
+    NvU64           hits;
+    NvU64           misses;
+} RMAPI_PARAM_COPY_CACHE_STRIPE;
+
+static struct
+{
+    NvBool                          bInitialized;
+    RMAPI_PARAM_COPY_CACHE_STRIPE   stripes[RMAPI_PARAM_COPY_CACHE_NUM_STRIPES];
+    // Uncached buffers never touch a stripe, so they are counted atomically
+    volatile NvU64                  uncached;
+} g_paramCopyCache;
+
+static RMAPI_PARAM_COPY_CACHE_STRIPE *
+_rmapiParamsCacheStripe(void)
+{
+    NvU64 hash = portThreadGetCurrentThreadId() * 0x9E3779B97F4A7C15ULL;
+    return &g_paramCopyCache.stripes[hash >> (64 - RMAPI_PARAM_COPY_CACHE_STRIPES_LOG2)];
+}
+
+static NvU32
+_rmapiParamsCacheClass(NvU32 paramsSize)
+{
+    NvU32 sizeClass = 0;
+
+    while ((1u << (RMAPI_PARAM_COPY_CACHE_MIN_SHIFT + sizeClass)) < paramsSize)
+        sizeClass++;
+
+    return sizeClass;
+}
+
+void
+rmapiParamsCacheInit(void)
+{
+    NvU32 i;
+
+    portMemSet(&g_paramCopyCache, 0, sizeof(g_paramCopyCache));
+
+    for (i = 0; i < RMAPI_PARAM_COPY_CACHE_NUM_STRIPES; i++)
+    {
+        g_paramCopyCache.stripes[i].pLock = portSyncSpinlockCreate(portMemAllocatorGetGlobalNonPaged());
+        if (g_paramCopyCache.stripes[i].pLock == NULL)
+        {
+            NV_PRINTF(LEVEL_WARNING, "Param copy cache disabled\n");
+            while (i-- > 0)
+                portSyncSpinlockDestroy(g_paramCopyCache.stripes[i].pLock);
+            return;
+        }
+    }
+
+    g_paramCopyCache.bInitialized = NV_TRUE;
+}
+
+void
+rmapiParamsCacheDestroy(void)
+{
+    RMAPI_PARAM_COPY_CACHE_STATS stats;
+    NvU32 i, j;
+
+    if (!g_paramCopyCache.bInitialized)
+        return;
+
+    rmapiParamsCacheGetStats(&stats);
+    NV_PRINTF(LEVEL_INFO,
+              "Param copy cache: hits %llu misses %llu uncached %llu\n",
+              stats.hits, stats.misses, stats.uncached);
+
+    g_paramCopyCache.bInitialized = NV_FALSE;
+
+    for (i = 0; i < RMAPI_PARAM_COPY_CACHE_NUM_STRIPES; i++)
+    {
+        RMAPI_PARAM_COPY_CACHE_STRIPE *pStripe = &g_paramCopyCache.stripes[i];
+
+        for (j = 0; j < RMAPI_PARAM_COPY_CACHE_NUM_CLASSES; j++)
+        {
+            while (pStripe->numFree[j] > 0)
+                portMemFree(pStripe->pFree[j][--pStripe->numFree[j]]);
+        }
+
+        portSyncSpinlockDestroy(pStripe->pLock);
+    }
+}
+
+void
+rmapiParamsCacheGetStats(RMAPI_PARAM_COPY_CACHE_STATS *pStats)
+{
+    NvU32 i;
+
+    portMemSet(pStats, 0, sizeof(*pStats));
+
+    if (!g_paramCopyCache.bInitialized)
+        return;
+
+    for (i = 0; i < RMAPI_PARAM_COPY_CACHE_NUM_STRIPES; i++)
+    {
+        RMAPI_PARAM_COPY_CACHE_STRIPE *pStripe = &g_paramCopyCache.stripes[i];
+
+        portSyncSpinlockAcquire(pStripe->pLock);
+        pStats->hits   += pStripe->hits;
+        pStats->misses += pStripe->misses;
+        portSyncSpinlockRelease(pStripe->pLock);
+    }
+
+    pStats->uncached = portAtomicExAddU64(&g_paramCopyCache.uncached, 0);
+}
+
+//
+// Returns a buffer of at least paramsSize bytes.  *pbRecycled is set if the
+// buffer previously held another caller's params.
+//
+static void *
+_rmapiParamsBufferAlloc(NvU32 paramsSize, NvBool *pbRecycled)
+{
+    RMAPI_PARAM_COPY_CACHE_STRIPE *pStripe;
+    NvU32 sizeClass;
+    void *pBuffer = NULL;
+
+    *pbRecycled = NV_FALSE;
+
+    if (!g_paramCopyCache.bInitialized)
+        return portMemAllocNonPaged(paramsSize);
+
+    if (paramsSize > RMAPI_PARAM_COPY_CACHE_MAX_SIZE)
+    {
+        portAtomicExIncrementU64(&g_paramCopyCache.uncached);
+        return portMemAllocNonPaged(paramsSize);
+    }
+
+    pStripe = _rmapiParamsCacheStripe();
+    sizeClass = _rmapiParamsCacheClass(paramsSize);
+
+    portSyncSpinlockAcquire(pStripe->pLock);
+    if (pStripe->numFree[sizeClass] > 0)
+    {
+        pBuffer = pStripe->pFree[sizeClass][--pStripe->numFree[sizeClass]];
+        pStripe->hits++;
+    }
+    else
+    {
+        pStripe->misses++;
+    }
+    portSyncSpinlockRelease(pStripe->pLock);
+
+    if (pBuffer != NULL)
+    {
+        *pbRecycled = NV_TRUE;
+        return pBuffer;
+    }
+
+    return portMemAllocNonPaged(1u << (RMAPI_PARAM_COPY_CACHE_MIN_SHIFT + sizeClass));
+}
+
+static void
+_rmapiParamsBufferFree(void *pBuffer, NvU32 paramsSize)
+{
+    RMAPI_PARAM_COPY_CACHE_STRIPE *pStripe;
+    NvU32 sizeClass;
+
+    if (!g_paramCopyCache.bInitialized || (paramsSize > RMAPI_PARAM_COPY_CACHE_MAX_SIZE))
+    {
+        portMemFree(pBuffer);
+        return;
+    }
+
+    sizeClass = _rmapiParamsCacheClass(paramsSize);
+    pStripe = _rmapiParamsCacheStripe();
+
+    portSyncSpinlockAcquire(pStripe->pLock);
+    if (pStripe->numFree[sizeClass] < RMAPI_PARAM_COPY_CACHE_DEPTH)
+    {
+        pStripe->pFree[sizeClass][pStripe->numFree[sizeClass]++] = pBuffer;
+        pBuffer = NULL;
+    }
+    portSyncSpinlockRelease(pStripe->pLock);
+
+    if (pBuffer != NULL)
+        portMemFree(pBuffer);
+}
+
 NV_STATUS rmapiParamsAcquire
 (
     RMAPI_PARAM_COPY  *pParamCopy,
@@ -35,6 +237,7 @@ NV_STATUS rmapiParamsAcquire
 )
 {
     NvBool      bUseParamsDirectly;
+    NvBool      bRecycled = NV_FALSE;
     void       *pKernelParams = NULL;
     NV_STATUS   rmStatus = NV_OK;
     OBJSYS     *pSys = SYS_GET_INSTANCE();
@@ -89,7 +292,7 @@ NV_STATUS rmapiParamsAcquire
         }
     }
 
-    pKernelParams = portMemAllocNonPaged(pParamCopy->paramsSize);
+    pKernelParams = _rmapiParamsBufferAlloc(pParamCopy->paramsSize, &bRecycled);
     if (pKernelParams == NULL)
     {
         rmStatus = NV_ERR_INSUFFICIENT_RESOURCES;
@@ -103,7 +306,8 @@ NV_STATUS rmapiParamsAcquire
     {
         if (pParamCopy->flags & RMAPI_PARAM_COPY_FLAGS_SKIP_COPYIN)
         {
-            if (pParamCopy->flags & RMAPI_PARAM_COPY_FLAGS_ZERO_BUFFER)
+            // Never hand out another caller's stale params
+            if ((pParamCopy->flags & RMAPI_PARAM_COPY_FLAGS_ZERO_BUFFER) || bRecycled)
                 portMemSet(pKernelParams, 0, pParamCopy->paramsSize);
         }
         else
@@ -124,7 +328,7 @@ done:
     {
         if (pKernelParams != NULL)
         {
-            portMemFree(pKernelParams);
+            _rmapiParamsBufferFree(pKernelParams, pParamCopy->paramsSize);
             pKernelParams = NULL;
         }
     }
@@ -174,7 +378,7 @@ NV_STATUS rmapiParamsRelease
         }
     }
 
-    portMemFree(*pParamCopy->ppKernelParams);
+    _rmapiParamsBufferFree(*pParamCopy->ppKernelParams, pParamCopy->paramsSize);
 
 done:
     // no longer ok to use the ptr, even if it was a direct usage
@@ -230,10 +230,9 @@ rmresControl_Prologue_IMPL
 
     if (rmapiControlIsCacheable(pParams->pCookie->ctrlFlags, IS_GSP_CLIENT(pGpu)))
     {
-        void* cached = rmapiControlCacheGet(pParams->hClient, pParams->hObject, pParams->cmd);
-        if (cached)
+        if (rmapiControlCacheGet(pParams->hClient, pParams->hObject, pParams->cmd,
+                                 pParams->pParams, pParams->paramsSize) == NV_OK)
         {
-            portMemCopy(pParams->pParams, pParams->paramsSize, cached, pParams->paramsSize);
             return NV_WARN_NOTHING_TO_DO;
         }
     }
@@ -290,12 +289,9 @@ rmresControl_Epilogue_IMPL
 
     if (rmapiControlIsCacheable(pParams->pCookie->ctrlFlags, IS_GSP_CLIENT(pGpu)))
     {
-        void* cached = rmapiControlCacheGet(pParams->hClient, pParams->hObject, pParams->cmd);
-        if (!cached)
-        {
-            NV_PRINTF(LEVEL_INFO, "rmControl: caching cmd 0x%x params\n", pParams->cmd);
-            NV_ASSERT_OK(rmapiControlCacheSet(pParams->hClient, pParams->hObject, pParams->cmd,
-                NvP64_VALUE(pParams->pParams), pParams->paramsSize));
-        }
+        // No-op if the result was already cached
+        NV_PRINTF(LEVEL_INFO, "rmControl: caching cmd 0x%x params\n", pParams->cmd);
+        NV_ASSERT_OK(rmapiControlCacheSet(pParams->hClient, pParams->hObject, pParams->cmd,
+            NvP64_VALUE(pParams->pParams), pParams->paramsSize));
     }
 }
@@ -80,7 +80,7 @@ rmapiInitialize
     }
 
     RsResInfoInitialize();
-    status = serverConstruct(&g_resServ, RS_PRIV_LEVEL_HOST, 0);
+    status = serverConstruct(&g_resServ, RS_PRIV_LEVEL_HOST, 0, RS_CLIENT_INDEX_HASH);
 
     if (status != NV_OK)
     {
@@ -90,6 +90,7 @@ rmapiInitialize
     }
 
     rmapiControlCacheInit();
+    rmapiParamsCacheInit();
 
     listInit(&g_clientListBehindGpusLock, g_resServ.pAllocator);
     listInit(&g_userInfoList, g_resServ.pAllocator);
@@ -124,6 +125,7 @@ rmapiShutdown
     _rmapiLockFree();
 
     rmapiControlCacheFree();
+    rmapiParamsCacheDestroy();
 
     g_bResServInit = NV_FALSE;
 }
@@ -20,6 +20,7 @@
  * FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER
  * DEALINGS IN THE SOFTWARE.
  */
+#include "containers/list.h"
 #include "containers/map.h"
 #include "containers/multimap.h"
 #include "nvctassert.h"
@@ -29,17 +30,35 @@
 #include "rmapi/control.h"
 #include "rmapi/rmapi.h"
 
-typedef struct
+typedef struct RmapiControlCacheEntry RmapiControlCacheEntry;
+
+struct RmapiControlCacheEntry
 {
     void* params;
-} RmapiControlCacheEntry;
+    NvU32 paramsSize;
+    NvU32 cmd;
+    NvU64 key;
+    ListNode lruNode;
+};
 
 MAKE_MULTIMAP(CachedCallParams, RmapiControlCacheEntry);
+MAKE_INTRUSIVE_LIST(CachedCallLru, RmapiControlCacheEntry, lruNode);
 
 ct_assert(sizeof(NvHandle) <= 4);
 
 #define CLIENT_KEY_SHIFT (sizeof(NvHandle) * 8)
 
+//
+// The cache is split into shards selected by a hash of (hClient, hObject), so
+// that clients polling different objects do not serialize on a single mutex.
+// Must be a power of 2.
+//
+#define RMAPI_CONTROL_CACHE_SHARDS_LOG2 4
+#define RMAPI_CONTROL_CACHE_SHARDS      (1 << RMAPI_CONTROL_CACHE_SHARDS_LOG2)
+
+// Bytes charged against the budget for each entry in addition to its params
+#define RMAPI_CONTROL_CACHE_ENTRY_OVERHEAD (sizeof(RmapiControlCacheEntry) + 4 * sizeof(void*))
+
 static NvHandle keyToClient(NvU64 key)
 {
     return (key >> CLIENT_KEY_SHIFT);
@@ -50,13 +69,75 @@ static NvU64 handlesToKey(NvHandle hClient, NvHandle hObject)
     return ((NvU64)hClient << CLIENT_KEY_SHIFT) | hObject;
 }
 
-static struct {
-    /* NOTE: Size unbounded for now */
+typedef struct
+{
+    PORT_MUTEX *mtx;
     CachedCallParams cachedCallParams;
+    /* Most recently used entry at the head */
+    CachedCallLru lru;
+    /* Counted under mtx; bounded per-cmd table so that accounting never allocates */
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU64 size;
+} RmapiControlCacheShard;
+
+static struct {
+    RmapiControlCacheShard shards[RMAPI_CONTROL_CACHE_SHARDS];
+    /* Byte budget per shard; 0 means unbounded */
+    NvU64 shardBudget;
     NvU32 mode;
-    PORT_MUTEX *mtx;
 } RmapiControlCache;
 
+static RmapiControlCacheShard *keyToShard(NvU64 key)
+{
+    // Fibonacci hashing; handles are allocated sequentially.
+    NvU64 hash = key * 0x9E3779B97F4A7C15ULL;
+    return &RmapiControlCache.shards[hash >> (64 - RMAPI_CONTROL_CACHE_SHARDS_LOG2)];
+}
+
+static NvU64 entrySize(NvU32 paramsSize)
+{
+    return (NvU64)paramsSize + RMAPI_CONTROL_CACHE_ENTRY_OVERHEAD;
+}
+
+static void freeShard(RmapiControlCacheShard *pShard);
+
+/* Finds or claims the counters for cmd, falling back to the shared overflow bucket. */
+static RMAPI_CONTROL_CACHE_CMD_STATS *cmdStats(RMAPI_CONTROL_CACHE_STATS *pStats, NvU32 cmd)
+{
+    NvU32 i;
+
+    for (i = 0; i < pStats->numCmds; i++)
+    {
+        if (pStats->cmds[i].cmd == cmd)
+            return &pStats->cmds[i];
+    }
+
+    if (pStats->numCmds < RMAPI_CONTROL_CACHE_STATS_CMDS)
+    {
+        pStats->cmds[pStats->numCmds].cmd = cmd;
+        return &pStats->cmds[pStats->numCmds++];
+    }
+
+    return &pStats->other;
+}
+
+static void addStats
+(
+    RMAPI_CONTROL_CACHE_STATS *pStats,
+    RMAPI_CONTROL_CACHE_CMD_STATS *pCmdStats,
+    NvU64 hits,
+    NvU64 misses,
+    NvU64 evictions
+)
+{
+    pCmdStats->hits      += hits;
+    pCmdStats->misses    += misses;
+    pCmdStats->evictions += evictions;
+    pStats->hits         += hits;
+    pStats->misses       += misses;
+    pStats->evictions    += evictions;
+}
+
 NvBool rmapiControlIsCacheable(NvU32 flags, NvBool isGSPClient)
 {
     if (RmapiControlCache.mode == NV_REG_STR_RM_CACHEABLE_CONTROLS_ENABLE)
@@ -74,33 +155,127 @@ NvBool rmapiControlIsCacheable(NvU32 flags, NvBool isGSPClient)
 
 void rmapiControlCacheInit()
 {
+    NvU32 maxSize = NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_SIZE_DEFAULT;
+    NvU32 i;
+
     RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_GSP_ONLY;
 
     osReadRegistryDword(NULL, NV_REG_STR_RM_CACHEABLE_CONTROLS, &RmapiControlCache.mode);
-    NV_PRINTF(LEVEL_INFO, "using cache mode %d\n", RmapiControlCache.mode);
+    osReadRegistryDword(NULL, NV_REG_STR_RM_CACHEABLE_CONTROLS_MAX_SIZE, &maxSize);
+    NV_PRINTF(LEVEL_INFO, "using cache mode %d, max size 0x%x\n", RmapiControlCache.mode, maxSize);
+
+    RmapiControlCache.shardBudget = (maxSize == 0) ? 0 :
+        NV_MAX(maxSize / RMAPI_CONTROL_CACHE_SHARDS, entrySize(0));
 
     if (RmapiControlCache.mode)
     {
-        multimapInit(&RmapiControlCache.cachedCallParams, portMemAllocatorGetGlobalNonPaged());
-        RmapiControlCache.mtx = portSyncMutexCreate(portMemAllocatorGetGlobalNonPaged());
-        if (!RmapiControlCache.mtx)
+        for (i = 0; i < RMAPI_CONTROL_CACHE_SHARDS; i++)
         {
-            NV_PRINTF(LEVEL_ERROR, "failed to create mutex");
-            RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_DISABLE;
+            RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
+
+            multimapInit(&pShard->cachedCallParams, portMemAllocatorGetGlobalNonPaged());
+            listInitIntrusive(&pShard->lru);
+            portMemSet(&pShard->stats, 0, sizeof(pShard->stats));
+            pShard->size = 0;
+            pShard->mtx = portSyncMutexCreate(portMemAllocatorGetGlobalNonPaged());
+            if (!pShard->mtx)
+            {
+                NV_PRINTF(LEVEL_ERROR, "failed to create mutex");
+                do
+                {
+                    freeShard(&RmapiControlCache.shards[i]);
+                } while (i-- > 0);
+                RmapiControlCache.mode = NV_REG_STR_RM_CACHEABLE_CONTROLS_DISABLE;
+                return;
+            }
         }
     }
 }
 
-void* rmapiControlCacheGet(NvHandle hClient, NvHandle hObject, NvU32 cmd)
+static void freeShard(RmapiControlCacheShard *pShard)
+{
+    CachedCallParamsIter it;
+
+    it = multimapItemIterAll(&pShard->cachedCallParams);
+    while (multimapItemIterNext(&it))
+    {
+        RmapiControlCacheEntry* entry = it.pValue;
+        portMemFree(entry->params);
+    }
+
+    listDestroy(&pShard->lru);
+    multimapDestroy(&pShard->cachedCallParams);
+    if (pShard->mtx)
+        portSyncMutexDestroy(pShard->mtx);
+    pShard->mtx = NULL;
+    pShard->size = 0;
+}
+
+/* Unlinks and frees an entry, dropping its submap once empty. Shard lock must be held. */
+static void removeEntry(RmapiControlCacheShard *pShard, RmapiControlCacheEntry *entry)
+{
+    CachedCallParamsSubmap* submap = multimapFindSubmap(&pShard->cachedCallParams, entry->key);
+
+    pShard->size -= entrySize(entry->paramsSize);
+    listRemove(&pShard->lru, entry);
+    portMemFree(entry->params);
+    multimapRemoveItem(&pShard->cachedCallParams, entry);
+
+    if (submap && multimapCountSubmapItems(&pShard->cachedCallParams, submap) == 0)
+        multimapRemoveSubmap(&pShard->cachedCallParams, submap);
+}
+
+/* Evicts least recently used entries until the shard fits its budget. Shard lock must be held. */
+static void evictEntries(RmapiControlCacheShard *pShard)
+{
+    while ((RmapiControlCache.shardBudget != 0) &&
+           (pShard->size > RmapiControlCache.shardBudget))
+    {
+        RmapiControlCacheEntry* entry = listTail(&pShard->lru);
+
+        if (entry == NULL)
+            break;
+
+        NV_PRINTF(LEVEL_INFO, "evicting cached cmd 0x%x for key 0x%llx\n", entry->cmd, entry->key);
+
+        addStats(&pShard->stats, cmdStats(&pShard->stats, entry->cmd), 0, 0, 1);
+        removeEntry(pShard, entry);
+    }
+}
+
+NV_STATUS rmapiControlCacheGet
+(
+    NvHandle hClient,
+    NvHandle hObject,
+    NvU32 cmd,
+    void* params,
+    NvU32 paramsSize
+)
 {
+    NvU64 key = handlesToKey(hClient, hObject);
+    RmapiControlCacheShard *pShard = keyToShard(key);
+    NV_STATUS status = NV_ERR_OBJECT_NOT_FOUND;
+
     NV_PRINTF(LEVEL_INFO, "cache lookup for 0x%x 0x%x 0x%x\n", hClient, hObject, cmd);
-    portSyncMutexAcquire(RmapiControlCache.mtx);
-    RmapiControlCacheEntry* entry = multimapFindItem(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject), cmd);
-    portSyncMutexRelease(RmapiControlCache.mtx);
+    portSyncMutexAcquire(pShard->mtx);
+    RmapiControlCacheEntry* entry = multimapFindItem(&pShard->cachedCallParams, key, cmd);
+    if (entry && (entry->paramsSize == paramsSize))
+    {
+        portMemCopy(params, paramsSize, entry->params, paramsSize);
+
+        listRemove(&pShard->lru, entry);
+        listPrependExisting(&pShard->lru, entry);
+        addStats(&pShard->stats, cmdStats(&pShard->stats, cmd), 1, 0, 0);
+        status = NV_OK;
+    }
+    else
+    {
+        addStats(&pShard->stats, cmdStats(&pShard->stats, cmd), 0, 1, 0);
+    }
+    portSyncMutexRelease(pShard->mtx);
     NV_PRINTF(LEVEL_INFO, "cache entry for 0x%x 0x%x 0x%x: entry 0x%p\n", hClient, hObject, cmd, entry);
-    if (entry)
-        return entry->params;
-    return NULL;
+
+    return status;
 }
 
 NV_STATUS rmapiControlCacheSet
@@ -112,26 +287,36 @@ NV_STATUS rmapiControlCacheSet
     NvU32 paramsSize
 )
 {
-    portSyncMutexAcquire(RmapiControlCache.mtx);
+    NvU64 key = handlesToKey(hClient, hObject);
+    RmapiControlCacheShard *pShard = keyToShard(key);
+
+    // Entries larger than a whole shard would only evict everything else.
+    if ((RmapiControlCache.shardBudget != 0) &&
+        (entrySize(paramsSize) > RmapiControlCache.shardBudget))
+    {
+        return NV_OK;
+    }
+
+    portSyncMutexAcquire(pShard->mtx);
     NV_STATUS status = NV_OK;
-    RmapiControlCacheEntry* entry = multimapFindItem(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject), cmd);
+    RmapiControlCacheEntry* entry = multimapFindItem(&pShard->cachedCallParams, key, cmd);
     CachedCallParamsSubmap* insertedSubmap = NULL;
 
-    if (!entry)
+    // The first result cached for a control is kept until it is evicted or freed.
+    if (entry)
+        goto done;
+
+    if (!multimapFindSubmap(&pShard->cachedCallParams, key))
     {
-        if (!multimapFindSubmap(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject)))
+        insertedSubmap = multimapInsertSubmap(&pShard->cachedCallParams, key);
+        if (!insertedSubmap)
         {
-            insertedSubmap = multimapInsertSubmap(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject));
-            if (!insertedSubmap)
-            {
-                status = NV_ERR_NO_MEMORY;
-                goto done;
-            }
+            status = NV_ERR_NO_MEMORY;
+            goto done;
         }
-
-        entry = multimapInsertItemNew(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject), cmd);
     }
 
+    entry = multimapInsertItemNew(&pShard->cachedCallParams, key, cmd);
     if (!entry)
     {
         status = NV_ERR_NO_MEMORY;
@@ -146,6 +331,13 @@ NV_STATUS rmapiControlCacheSet
     }
 
     portMemCopy(entry->params, paramsSize, params, paramsSize);
+    entry->paramsSize = paramsSize;
+    entry->cmd = cmd;
+    entry->key = key;
+    listPrependExisting(&pShard->lru, entry);
+    pShard->size += entrySize(paramsSize);
+
+    evictEntries(pShard);
 
 done:
     if (status != NV_OK)
@@ -154,101 +346,146 @@ done:
         if (entry)
         {
             portMemFree(entry->params);
-            multimapRemoveItem(&RmapiControlCache.cachedCallParams, entry);
+            multimapRemoveItem(&pShard->cachedCallParams, entry);
         }
 
         if (insertedSubmap)
-            multimapRemoveSubmap(&RmapiControlCache.cachedCallParams, insertedSubmap);
+            multimapRemoveSubmap(&pShard->cachedCallParams, insertedSubmap);
     }
 
-    portSyncMutexRelease(RmapiControlCache.mtx);
+    portSyncMutexRelease(pShard->mtx);
 
     return status;
 }
 
-static void freeSubmap(CachedCallParamsSubmap* submap)
+static void freeSubmap(RmapiControlCacheShard *pShard, CachedCallParamsSubmap* submap)
 {
     /* (Sub)map modification invalidates the iterator, so we have to restart */
     while (NV_TRUE)
     {
-        CachedCallParamsIter it = multimapSubmapIterItems(&RmapiControlCache.cachedCallParams, submap);
+        CachedCallParamsIter it = multimapSubmapIterItems(&pShard->cachedCallParams, submap);
 
         if (multimapItemIterNext(&it))
         {
             RmapiControlCacheEntry* entry = it.pValue;
+            pShard->size -= entrySize(entry->paramsSize);
+            listRemove(&pShard->lru, entry);
             portMemFree(entry->params);
-            multimapRemoveItem(&RmapiControlCache.cachedCallParams, entry);
+            multimapRemoveItem(&pShard->cachedCallParams, entry);
         }
         else
         {
             break;
         }
     }
-    multimapRemoveSubmap(&RmapiControlCache.cachedCallParams, submap);
+    multimapRemoveSubmap(&pShard->cachedCallParams, submap);
 }
 
 void rmapiControlCacheFreeClient(NvHandle hClient)
 {
+    NvU32 i;
+
     if (!RmapiControlCache.mode)
         return;
 
-    portSyncMutexAcquire(RmapiControlCache.mtx);
-    while (NV_TRUE)
+    // A client's objects are spread over every shard.
+    for (i = 0; i < RMAPI_CONTROL_CACHE_SHARDS; i++)
     {
-        CachedCallParamsSubmap* start = multimapFindSubmapGEQ(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, 0));
-        CachedCallParamsSubmap* end = multimapFindSubmapLEQ(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, NV_U32_MAX));
+        RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
 
-        if (!start || !end ||
-            keyToClient(multimapSubmapKey(&RmapiControlCache.cachedCallParams, start)) != hClient ||
-            keyToClient(multimapSubmapKey(&RmapiControlCache.cachedCallParams, end)) != hClient)
+        portSyncMutexAcquire(pShard->mtx);
+        while (NV_TRUE)
         {
-            break;
-        }
+            CachedCallParamsSubmap* start = multimapFindSubmapGEQ(&pShard->cachedCallParams, handlesToKey(hClient, 0));
+            CachedCallParamsSubmap* end = multimapFindSubmapLEQ(&pShard->cachedCallParams, handlesToKey(hClient, NV_U32_MAX));
 
-        CachedCallParamsSupermapIter it = multimapSubmapIterRange(&RmapiControlCache.cachedCallParams, start, end);
+            if (!start || !end ||
+                keyToClient(multimapSubmapKey(&pShard->cachedCallParams, start)) != hClient ||
+                keyToClient(multimapSubmapKey(&pShard->cachedCallParams, end)) != hClient)
+            {
+                break;
+            }
 
-        if (multimapSubmapIterNext(&it))
-        {
-            CachedCallParamsSubmap* submap = it.pValue;
-            freeSubmap(submap);
-        }
-        else
-        {
-            break;
+            CachedCallParamsSupermapIter it = multimapSubmapIterRange(&pShard->cachedCallParams, start, end);
+
+            if (multimapSubmapIterNext(&it))
+            {
+                CachedCallParamsSubmap* submap = it.pValue;
+                freeSubmap(pShard, submap);
+            }
+            else
+            {
+                break;
+            }
         }
+        portSyncMutexRelease(pShard->mtx);
     }
-    portSyncMutexRelease(RmapiControlCache.mtx);
 }
 
 void rmapiControlCacheFreeObject(NvHandle hClient, NvHandle hObject)
 {
+    NvU64 key = handlesToKey(hClient, hObject);
+    RmapiControlCacheShard *pShard;
     CachedCallParamsSubmap* submap;
 
     if (!RmapiControlCache.mode)
         return;
 
-    portSyncMutexAcquire(RmapiControlCache.mtx);
+    pShard = keyToShard(key);
+    portSyncMutexAcquire(pShard->mtx);
 
-    submap = multimapFindSubmap(&RmapiControlCache.cachedCallParams, handlesToKey(hClient, hObject));
+    submap = multimapFindSubmap(&pShard->cachedCallParams, key);
     if (submap)
-        freeSubmap(submap);
+        freeSubmap(pShard, submap);
 
-    portSyncMutexRelease(RmapiControlCache.mtx);
+    portSyncMutexRelease(pShard->mtx);
+}
+
+NV_STATUS rmapiControlCacheGetStats(RMAPI_CONTROL_CACHE_STATS *pStats)
+{
+    NvU32 i;
+
+    NV_ASSERT_OR_RETURN(pStats != NULL, NV_ERR_INVALID_ARGUMENT);
+    portMemSet(pStats, 0, sizeof(*pStats));
+
+    if (!RmapiControlCache.mode)
+        return NV_ERR_NOT_SUPPORTED;
+
+    for (i = 0; i < RMAPI_CONTROL_CACHE_SHARDS; i++)
+    {
+        RmapiControlCacheShard *pShard = &RmapiControlCache.shards[i];
+        RMAPI_CONTROL_CACHE_STATS *pShardStats = &pShard->stats;
+        NvU32 j;
+
+        portSyncMutexAcquire(pShard->mtx);
+        for (j = 0; j < pShardStats->numCmds; j++)
+        {
+            RMAPI_CONTROL_CACHE_CMD_STATS *pCmd = &pShardStats->cmds[j];
+
+            addStats(pStats, cmdStats(pStats, pCmd->cmd),
+                     pCmd->hits, pCmd->misses, pCmd->evictions);
+        }
+        addStats(pStats, &pStats->other, pShardStats->other.hits,
+                 pShardStats->other.misses, pShardStats->other.evictions);
+        portSyncMutexRelease(pShard->mtx);
+    }
+
+    return NV_OK;
 }
 
 void rmapiControlCacheFree(void) {
-    CachedCallParamsIter it;
+    RMAPI_CONTROL_CACHE_STATS stats;
+    NvU32 i;
 
     if (!RmapiControlCache.mode)
         return;
 
-    it = multimapItemIterAll(&RmapiControlCache.cachedCallParams);
-    while (multimapItemIterNext(&it))
+    if (rmapiControlCacheGetStats(&stats) == NV_OK)
     {
-        RmapiControlCacheEntry* entry = it.pValue;
-        portMemFree(entry->params);
+        NV_PRINTF(LEVEL_INFO, "%llu hits, %llu misses, %llu evictions\n",
+                  stats.hits, stats.misses, stats.evictions);
     }
 
-    multimapDestroy(&RmapiControlCache.cachedCallParams);
-    portSyncMutexDestroy(RmapiControlCache.mtx);
+    for (i = 0; i < RMAPI_CONTROL_CACHE_SHARDS; i++)
+        freeShard(&RmapiControlCache.shards[i]);
 }
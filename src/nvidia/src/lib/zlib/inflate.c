@@ -125,6 +125,7 @@
 #define portMemSet  memset
 #define portMemAllocNonPaged malloc
 #define portMemFree  free
+#define portMemCopy(d, dl, s, sl) memcpy(d, s, sl)
 #define sizeof sizeof
 #define NV_PRINTF(a,b) printf(b)
 #endif
@@ -893,6 +894,87 @@ static NvU32 dynamic_huft_build(PGZ_INFLATE_STATE pGzState)
     return GZ_STATE_HUFT_OK;
 }
 
+/* NVIDIA addition: seek index.  Access points are recorded at deflate block
+   boundaries on the first pass through the stream, so that a read behind the
+   current slide window resumes from the nearest point instead of inflating
+   everything again from the start. */
+static void utilGzIndexAddPoint(PGZ_INFLATE_STATE pGzState)
+{
+    PGZ_INFLATE_INDEX pIndex = pGzState->pIndex;
+    PGZ_INFLATE_POINT pPoint;
+    NvU32 outPos = pGzState->outptr + pGzState->wp;
+    NvU32 lastPos = 0;
+
+    if (pIndex->count == GZ_INDEX_MAX_POINTS)
+        return;
+
+    if (pIndex->count != 0)
+    {
+        pPoint = &pIndex->points[pIndex->count - 1];
+        lastPos = pPoint->outptr + pPoint->wp;
+    }
+
+    // Only extend the index forwards; points behind the last one were
+    // already recorded on an earlier pass.
+    if (outPos < lastPos + pIndex->spacing)
+        return;
+
+    pPoint = &pIndex->points[pIndex->count];
+    if (pPoint->window == NULL)
+    {
+        pPoint->window = portMemAllocNonPaged(GZ_SLIDE_WINDOW_SIZE);
+        if (pPoint->window == NULL)
+            return;
+    }
+
+    portMemCopy(pPoint->window, GZ_SLIDE_WINDOW_SIZE, pGzState->window, GZ_SLIDE_WINDOW_SIZE);
+    pPoint->outptr = pGzState->outptr;
+    pPoint->inptr  = pGzState->inptr;
+    pPoint->bb     = pGzState->bb;
+    pPoint->bk     = pGzState->bk;
+    pPoint->wp     = pGzState->wp;
+    pIndex->count++;
+}
+
+/* Find the last access point at or before offset, if any. */
+static PGZ_INFLATE_POINT utilGzIndexFind(PGZ_INFLATE_INDEX pIndex, NvU32 offset)
+{
+    NvU32 lo = 0, hi;
+
+    if (pIndex == NULL || pIndex->count == 0 || pIndex->points[0].outptr > offset)
+        return NULL;
+
+    // points are sorted by output offset
+    hi = pIndex->count - 1;
+    while (lo < hi)
+    {
+        NvU32 mid = (lo + hi + 1) / 2;
+        if (pIndex->points[mid].outptr <= offset)
+            lo = mid;
+        else
+            hi = mid - 1;
+    }
+
+    return &pIndex->points[lo];
+}
+
+static void utilGzIndexDestroy(PGZ_INFLATE_STATE pGzState)
+{
+    NvU32 i;
+
+    if (pGzState->pIndex == NULL)
+        return;
+
+    for (i = 0; i < GZ_INDEX_MAX_POINTS; i++)
+    {
+        if (pGzState->pIndex->points[i].window != NULL)
+            portMemFree(pGzState->pIndex->points[i].window);
+    }
+
+    portMemFree(pGzState->pIndex);
+    pGzState->pIndex = NULL;
+}
+
 static
 NV_STATUS utilGzInit(const NvU8 *zArray, NvU8* oBuffer, NvU32 numTotalBytes, NvU8* window, PGZ_INFLATE_STATE pGzState)
 {
@@ -910,6 +992,27 @@ NV_STATUS utilGzInit(const NvU8 *zArray, NvU8* oBuffer, NvU32 numTotalBytes, NvU
     return NV_OK;
 }
 
+/* Restart decompression from pPoint, or from the beginning if it is NULL. */
+static void utilGzRestart(PGZ_INFLATE_STATE pGzState, PGZ_INFLATE_POINT pPoint)
+{
+    PGZ_INFLATE_INDEX pIndex = pGzState->pIndex;
+
+    huft_destroy(pGzState);
+
+    utilGzInit(pGzState->inbuf, pGzState->outbuf, pGzState->outBufSize, pGzState->window, pGzState);
+
+    pGzState->pIndex = pIndex;
+    if (pPoint != NULL)
+    {
+        portMemCopy(pGzState->window, GZ_SLIDE_WINDOW_SIZE, pPoint->window, GZ_SLIDE_WINDOW_SIZE);
+        pGzState->outptr = pPoint->outptr;
+        pGzState->inptr  = pPoint->inptr;
+        pGzState->bb     = pPoint->bb;
+        pGzState->bk     = pPoint->bk;
+        pGzState->wp     = pPoint->wp;
+    }
+}
+
 /* NVIDIA addition: give pointers to input and known-large-enough output buffers. */
 /* decompress an inflated entry                                                   */
 NV_STATUS utilGzAllocate(const NvU8 *zArray, NvU32 numTotalBytes, PGZ_INFLATE_STATE *ppGzState)
@@ -948,6 +1051,35 @@ done:
 
 }
 
+/* NVIDIA addition: build a seek index while data is read, with access points
+   at least spacing output bytes apart.  A spacing of 0 spreads the points
+   evenly over the whole output.  Each point costs one slide window of memory. */
+NV_STATUS utilGzIndexCreate(PGZ_INFLATE_STATE pGzState, NvU32 spacing)
+{
+    PGZ_INFLATE_INDEX pIndex;
+
+    if (pGzState == NULL)
+        return NV_ERR_INVALID_ARGUMENT;
+
+    if (pGzState->pIndex != NULL)
+        return NV_OK;
+
+    pIndex = portMemAllocNonPaged(sizeof(GZ_INFLATE_INDEX));
+    if (pIndex == NULL)
+        return NV_ERR_NO_MEMORY;
+
+    portMemSet(pIndex, 0, sizeof(GZ_INFLATE_INDEX));
+
+    if (spacing == 0)
+        spacing = pGzState->outBufSize / (GZ_INDEX_MAX_POINTS + 1);
+
+    // closer points than one window would not save any work
+    pIndex->spacing = (spacing < WSIZE) ? WSIZE : spacing;
+    pGzState->pIndex = pIndex;
+
+    return NV_OK;
+}
+
 NvU32 utilGzIterator(PGZ_INFLATE_STATE pGzState)
 {
     NvU32 t;  /* block type */
@@ -1058,6 +1190,11 @@ NvU32 utilGzIterator(PGZ_INFLATE_STATE pGzState)
         huft_destroy(pGzState);
         pGzState->newblock = 1;
 
+        if (pGzState->pIndex != NULL && !pGzState->e)
+        {
+            utilGzIndexAddPoint(pGzState);
+        }
+
         // current block is the last one, flush remain data in slide window
         if (pGzState->e)
         {
@@ -1081,6 +1218,7 @@ NvU32 utilGzIterator(PGZ_INFLATE_STATE pGzState)
 NV_STATUS utilGzDestroy(PGZ_INFLATE_STATE pGzState)
 {
     huft_destroy(pGzState);
+    utilGzIndexDestroy(pGzState);
     portMemFree(pGzState->window);
     portMemFree(pGzState);
     return NV_OK;
@@ -1088,9 +1226,8 @@ NV_STATUS utilGzDestroy(PGZ_INFLATE_STATE pGzState)
 
 NvU32 utilGzGetData(PGZ_INFLATE_STATE pGzState, NvU32 offset, NvU32 size, NvU8 * outBuffer)
 {
-    NvU32 sizew = 0, oldOutBufSize;
-    NvU8 * oldInBuf, *oldOutBuf;
-    uch * oldWindow;
+    NvU32 sizew = 0;
+    PGZ_INFLATE_POINT pPoint;
     NV_STATUS status = NV_OK;
 
     if (pGzState == NULL || outBuffer == NULL || offset >= pGzState->outBufSize)
@@ -1099,6 +1236,8 @@ NvU32 utilGzGetData(PGZ_INFLATE_STATE pGzState, NvU32 offset, NvU32 size, NvU8 *
     }
 
     pGzState->optSize = 0;
+    pPoint = utilGzIndexFind(pGzState->pIndex, offset);
+
     // check requested range [offset, offset + size) with outptr
     if (pGzState->outptr != 0)
     {
@@ -1130,18 +1269,19 @@ NvU32 utilGzGetData(PGZ_INFLATE_STATE pGzState, NvU32 offset, NvU32 size, NvU8 *
         }
         else
         {
-            // slide window passed requested range, restart decompression from beginning.
-            huft_destroy(pGzState);
-
-            oldInBuf  = pGzState->inbuf;
-            oldOutBuf = pGzState->outbuf;
-            oldOutBufSize = pGzState->outBufSize;
-            oldWindow = pGzState->window;
-
-            utilGzInit(oldInBuf, oldOutBuf, oldOutBufSize, oldWindow, pGzState);
+            // slide window passed requested range, restart decompression from
+            // the nearest access point, or from the beginning if there is none.
+            utilGzRestart(pGzState, pPoint);
         }
     }
 
+    // skip ahead if an access point lies between the current position and
+    // the requested range
+    if (sizew == 0 && pPoint != NULL && pPoint->outptr > pGzState->outptr)
+    {
+        utilGzRestart(pGzState, pPoint);
+    }
+
     pGzState->outLower = offset + sizew;
     pGzState->outUpper = offset + size - 1;
     pGzState->outbuf = outBuffer;
@@ -51,12 +51,33 @@ static NvU32        eheapGetNumBlocks(POBJEHEAP);
 static NV_STATUS  eheapGetBlockInfo(POBJEHEAP, NvU32, NVOS32_HEAP_DUMP_BLOCK *);
 static NV_STATUS  eheapSetOwnerIsolation(POBJEHEAP, NvBool, NvU32);
 static NvBool     _eheapCheckOwnership(POBJEHEAP, void*, NvU64, NvU64, PEMEMBLOCK, EHeapOwnershipComparator*);
+static NvBool     _eheapFitFreeBlock(POBJEHEAP, PEMEMBLOCK, NvU32, NvU64, NvU64, NvU64, NvU64, void*, EHeapOwnershipComparator*, NvU64 *, NvU64 *, NvU64 *);
+static NvBool     _eheapFindIndexedFreeBlock(POBJEHEAP, NvU32, NvU64, NvU64, NvU64, NvU64, void*, EHeapOwnershipComparator*, PEMEMBLOCK *, NvU64 *, NvU64 *, NvU64 *);
+static void       _eheapSizeClassInsert(POBJEHEAP, PEMEMBLOCK);
+static void       _eheapSizeClassRemove(POBJEHEAP, PEMEMBLOCK);
 
 void
 constructObjEHeap(POBJEHEAP pHeap, NvU64 Base, NvU64 LimitPlusOne, NvU32 sizeofMemBlock, NvU32 numPreAllocMemStruct)
+{
+    constructObjEHeapWithPolicy(pHeap, Base, LimitPlusOne, sizeofMemBlock, numPreAllocMemStruct,
+                                EHEAP_ALLOC_POLICY_LINEAR);
+}
+
+void
+constructObjEHeapWithPolicy
+(
+    POBJEHEAP          pHeap,
+    NvU64              Base,
+    NvU64              LimitPlusOne,
+    NvU32              sizeofMemBlock,
+    NvU32              numPreAllocMemStruct,
+    EHEAP_ALLOC_POLICY allocPolicy
+)
 {
     initPublicObjectFunctionPointers_EHeap(pHeap);
 
+    pHeap->allocPolicy = allocPolicy;
+
     eheapInit(pHeap, Base, LimitPlusOne, sizeofMemBlock, numPreAllocMemStruct);
 }
 
@@ -138,6 +159,70 @@ _eheapFreeMemStruct
     return NV_OK;
 }
 
+//
+// Size class of a free block: floor(log2(size - 1)), so class N holds blocks
+// of (2^N, 2^(N+1)] bytes, with class 0 also taking single byte blocks.
+// Every block in a class above that of a request is large enough for it.
+//
+static NvU32
+_eheapSizeClass
+(
+    NvU64 span
+)
+{
+    if (span == 0)
+        return 0;
+
+    return 63 - portUtilCountLeadingZeros64(span);
+}
+
+static void
+_eheapSizeClassInsert
+(
+    POBJEHEAP  pHeap,
+    PEMEMBLOCK block
+)
+{
+    NvU32 sizeClass;
+
+    if (pHeap->pSizeClassList == NULL)
+        return;
+
+    sizeClass = _eheapSizeClass(block->end - block->begin);
+
+    block->prevSizeFree = NULL;
+    block->nextSizeFree = pHeap->pSizeClassList[sizeClass];
+    if (block->nextSizeFree != NULL)
+        block->nextSizeFree->prevSizeFree = block;
+    pHeap->pSizeClassList[sizeClass] = block;
+}
+
+static void
+_eheapSizeClassRemove
+(
+    POBJEHEAP  pHeap,
+    PEMEMBLOCK block
+)
+{
+    NvU32 sizeClass;
+
+    if (pHeap->pSizeClassList == NULL)
+        return;
+
+    sizeClass = _eheapSizeClass(block->end - block->begin);
+
+    if (block->prevSizeFree != NULL)
+        block->prevSizeFree->nextSizeFree = block->nextSizeFree;
+    else
+        pHeap->pSizeClassList[sizeClass] = block->nextSizeFree;
+
+    if (block->nextSizeFree != NULL)
+        block->nextSizeFree->prevSizeFree = block->prevSizeFree;
+
+    block->prevSizeFree = NULL;
+    block->nextSizeFree = NULL;
+}
+
 //
 // Create a heap.  Even though we can return error here the resultant
 // object must be self consistent (zero pointers, etc) if there were
@@ -175,6 +260,25 @@ eheapInit
     pHeap->pBlockTree           = NULL;
     pHeap->bOwnerIsolation      = NV_FALSE;
     pHeap->ownerGranularity     = 0;
+    pHeap->pSizeClassList       = NULL;
+
+    //
+    // The indexed policies need the size class lists.  If they can't be
+    // allocated, fall back to walking the address list so the heap still
+    // works, just with first fit placement.
+    //
+    if (pHeap->allocPolicy != EHEAP_ALLOC_POLICY_LINEAR)
+    {
+        pHeap->pSizeClassList = portMemAllocNonPaged(EHEAP_NUM_SIZE_CLASSES * sizeof(PEMEMBLOCK));
+        if (pHeap->pSizeClassList != NULL)
+        {
+            portMemSet(pHeap->pSizeClassList, 0, EHEAP_NUM_SIZE_CLASSES * sizeof(PEMEMBLOCK));
+        }
+        else
+        {
+            pHeap->allocPolicy = EHEAP_ALLOC_POLICY_LINEAR;
+        }
+    }
 
     //
     // User requested a static eheap that has a list of pre-allocated
@@ -226,6 +330,7 @@ eheapInit
     pHeap->pBlockList     = block;
     pHeap->pFreeBlockList = block;
     pHeap->numBlocks      = 1;
+    _eheapSizeClassInsert(pHeap, block);
 
     portMemSet((void *)&block->node, 0, sizeof(NODE));
     block->node.keyStart = block->begin;
@@ -291,6 +396,12 @@ eheapDestruct
         pHeap->pBlockList = NULL;
     }
 
+    if (pHeap->pSizeClassList != NULL)
+    {
+        portMemFree(pHeap->pSizeClassList);
+        pHeap->pSizeClassList = NULL;
+    }
+
     return NV_OK;
 }
 
@@ -475,6 +586,18 @@ eheapAlloc
         goto failed;
     }
 
+    if (pHeap->allocPolicy != EHEAP_ALLOC_POLICY_LINEAR)
+    {
+        if (_eheapFindIndexedFreeBlock(pHeap, *flags, allocSize, offsetAlign,
+                                       rangeLo, rangeHi, pIsolationID, checker,
+                                       &blockFree, &allocLo, &allocAl, &allocHi))
+        {
+            goto got_one;
+        }
+
+        goto failed;
+    }
+
     blockFirstFree = pHeap->pFreeBlockList;
     if (!blockFirstFree)
         goto failed;
@@ -488,120 +611,13 @@ eheapAlloc
     blockFree = blockFirstFree;
     do
     {
-        NvU64 blockLo;
-        NvU64 blockHi;
-
-        //
-        // Is this block completely out of range?
-        //
-        if ( ( blockFree->end < rangeLo ) || ( blockFree->begin > rangeHi ) )
-        {
-            if ( *flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN )
-                blockFree = blockFree->prevFree;
-            else
-                blockFree = blockFree->nextFree;
-            continue;
-        }
-
-        //
-        // Find the intersection of the free block and the specified range.
-        //
-        blockLo = (rangeLo > blockFree->begin) ? rangeLo : blockFree->begin;
-        blockHi = (rangeHi < blockFree->end) ? rangeHi : blockFree->end;
-
-        if ( *flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN )
-        {
-            //
-            // Allocate from the top of the memory block.
-            //
-            allocLo   = (blockHi - allocSize + 1) / offsetAlign * offsetAlign;
-            allocAl   = allocLo;
-            allocHi   = allocAl + allocSize - 1;
-        }
-        else
-        {
-            //
-            // Allocate from the bottom of the memory block.
-            //
-            allocAl   = (blockLo + (offsetAlign - 1)) / offsetAlign * offsetAlign;
-            allocLo   = allocAl;
-            allocHi   = allocAl + allocSize - 1;
-        }
-
-        //
-        // Make sure no allocated block between ALIGN_DOWN(allocLo, granularity)
-        // and ALIGN_UP(allocHi, granularity) have a different owner than the current allocation
-        //
-        if (pHeap->bOwnerIsolation)
-        {
-            NV_ASSERT(NULL != checker);
-
-            if (_eheapCheckOwnership(pHeap, pIsolationID, allocLo, allocHi, blockFree, checker))
-            {
-                goto alloc_done;
-            }
-
-            //
-            // Try realloc if we still have enough free memory in current free block
-            //
-            if (*flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN)
-            {
-                NvU64 checkLo = NV_ALIGN_DOWN(allocLo, pHeap->ownerGranularity);
-
-                if (checkLo > blockFree->begin)
-                {
-                    blockHi = checkLo;
-
-                    allocLo = (blockHi - allocSize + 1) / offsetAlign * offsetAlign;
-                    allocAl = allocLo;
-                    allocHi = allocAl + allocSize - 1;
-
-                    if (_eheapCheckOwnership(pHeap, pIsolationID, allocLo, allocHi, blockFree, checker))
-                    {
-                        goto alloc_done;
-                    }
-                }
-            }
-            else
-            {
-                NvU64 checkHi = NV_ALIGN_UP(allocHi, pHeap->ownerGranularity);
-
-                if (checkHi < blockFree->end)
-                {
-                    blockLo = checkHi;
-
-                    allocAl = (blockLo + (offsetAlign - 1)) / offsetAlign * offsetAlign;
-                    allocLo = allocAl;
-                    allocHi = allocAl + allocSize - 1;
-
-                    if (_eheapCheckOwnership(pHeap, pIsolationID, allocLo, allocHi, blockFree, checker)) 
-                    {
-                        goto alloc_done;
-                    }
-                }
-            }
-
-            //
-            // Cannot find any available memory in current free block, go to the next
-            //
-            goto next_free;
-        }
-
-alloc_done:
-        //
-        // Does the desired range fall completely within this block?
-        // Also make sure it does not wrap-around.
-        // Also make sure it is within the desired range.
-        //
-        if ((allocLo >= blockFree->begin) && (allocHi <= blockFree->end))
+        if (_eheapFitFreeBlock(pHeap, blockFree, *flags, allocSize, offsetAlign,
+                               rangeLo, rangeHi, pIsolationID, checker,
+                               &allocLo, &allocAl, &allocHi))
         {
-            if (allocLo <= allocHi)
-                if ((allocLo >= rangeLo) && (allocHi <= rangeHi))
-                    goto got_one;
-
+            goto got_one;
         }
 
-next_free:
         if ( *flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN )
             blockFree = blockFree->prevFree;
         else
@@ -629,6 +645,7 @@ next_free:
         //
         blockFree->nextFree->prevFree = blockFree->prevFree;
         blockFree->prevFree->nextFree = blockFree->nextFree;
+        _eheapSizeClassRemove(pHeap, blockFree);
         if (pHeap->pFreeBlockList == blockFree)
         {
             //
@@ -692,7 +709,10 @@ next_free:
             blockSplit->align = blockSplit->begin;
             blockSplit->end   = blockFree->end;
             blockSplit->pData = (void*)(blockNew+1);
+            _eheapSizeClassRemove(pHeap, blockFree);
             blockFree->end    = blockNew->begin - 1;
+            _eheapSizeClassInsert(pHeap, blockFree);
+            _eheapSizeClassInsert(pHeap, blockSplit);
             //
             // Insert free split block into free list.
             //
@@ -752,7 +772,9 @@ next_free:
             //
             // New block inserted after free block.
             //
+            _eheapSizeClassRemove(pHeap, blockFree);
             blockFree->end = blockNew->begin - 1;
+            _eheapSizeClassInsert(pHeap, blockFree);
             blockNew->next = blockFree->next;
             blockNew->prev = blockFree;
             blockFree->next->prev = blockNew;
@@ -789,7 +811,9 @@ next_free:
             //
             // New block inserted before free block.
             //
+            _eheapSizeClassRemove(pHeap, blockFree);
             blockFree->begin = blockNew->end + 1;
+            _eheapSizeClassInsert(pHeap, blockFree);
             blockFree->align = blockFree->begin;
             blockNew->next   = blockFree;
             blockNew->prev   = blockFree->prev;
@@ -840,6 +864,214 @@ next_free:
     return NV_OK;
 }
 
+//
+// Try to place an allocation inside a single free block, honouring the
+// allocation range, alignment, growth direction and owner isolation.
+// Returns NV_TRUE with the placement in pAllocLo/pAllocAl/pAllocHi on success.
+//
+static NvBool
+_eheapFitFreeBlock
+(
+    POBJEHEAP                 pHeap,
+    PEMEMBLOCK                blockFree,
+    NvU32                     flags,
+    NvU64                     allocSize,
+    NvU64                     offsetAlign,
+    NvU64                     rangeLo,
+    NvU64                     rangeHi,
+    void                     *pIsolationID,
+    EHeapOwnershipComparator *checker,
+    NvU64                    *pAllocLo,
+    NvU64                    *pAllocAl,
+    NvU64                    *pAllocHi
+)
+{
+    NvU64 blockLo;
+    NvU64 blockHi;
+    NvU64 allocLo, allocAl, allocHi;
+
+    //
+    // Is this block completely out of range?
+    //
+    if ( ( blockFree->end < rangeLo ) || ( blockFree->begin > rangeHi ) )
+        return NV_FALSE;
+
+    //
+    // Find the intersection of the free block and the specified range.
+    //
+    blockLo = (rangeLo > blockFree->begin) ? rangeLo : blockFree->begin;
+    blockHi = (rangeHi < blockFree->end) ? rangeHi : blockFree->end;
+
+    if ( flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN )
+    {
+        //
+        // Allocate from the top of the memory block.
+        //
+        allocLo   = (blockHi - allocSize + 1) / offsetAlign * offsetAlign;
+        allocAl   = allocLo;
+        allocHi   = allocAl + allocSize - 1;
+    }
+    else
+    {
+        //
+        // Allocate from the bottom of the memory block.
+        //
+        allocAl   = (blockLo + (offsetAlign - 1)) / offsetAlign * offsetAlign;
+        allocLo   = allocAl;
+        allocHi   = allocAl + allocSize - 1;
+    }
+
+    //
+    // Make sure no allocated block between ALIGN_DOWN(allocLo, granularity)
+    // and ALIGN_UP(allocHi, granularity) have a different owner than the current allocation
+    //
+    if (pHeap->bOwnerIsolation)
+    {
+        NvBool bOwnerOk;
+
+        NV_ASSERT(NULL != checker);
+
+        bOwnerOk = _eheapCheckOwnership(pHeap, pIsolationID, allocLo, allocHi, blockFree, checker);
+
+        //
+        // Try realloc if we still have enough free memory in current free block
+        //
+        if (!bOwnerOk && (flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN))
+        {
+            NvU64 checkLo = NV_ALIGN_DOWN(allocLo, pHeap->ownerGranularity);
+
+            if (checkLo > blockFree->begin)
+            {
+                blockHi = checkLo;
+
+                allocLo = (blockHi - allocSize + 1) / offsetAlign * offsetAlign;
+                allocAl = allocLo;
+                allocHi = allocAl + allocSize - 1;
+
+                bOwnerOk = _eheapCheckOwnership(pHeap, pIsolationID, allocLo, allocHi, blockFree, checker);
+            }
+        }
+        else if (!bOwnerOk)
+        {
+            NvU64 checkHi = NV_ALIGN_UP(allocHi, pHeap->ownerGranularity);
+
+            if (checkHi < blockFree->end)
+            {
+                blockLo = checkHi;
+
+                allocAl = (blockLo + (offsetAlign - 1)) / offsetAlign * offsetAlign;
+                allocLo = allocAl;
+                allocHi = allocAl + allocSize - 1;
+
+                bOwnerOk = _eheapCheckOwnership(pHeap, pIsolationID, allocLo, allocHi, blockFree, checker);
+            }
+        }
+
+        //
+        // Cannot find any available memory in current free block
+        //
+        if (!bOwnerOk)
+            return NV_FALSE;
+    }
+
+    //
+    // Does the desired range fall completely within this block?
+    // Also make sure it does not wrap-around.
+    // Also make sure it is within the desired range.
+    //
+    if ((allocLo >= blockFree->begin) && (allocHi <= blockFree->end) &&
+        (allocLo <= allocHi) &&
+        (allocLo >= rangeLo) && (allocHi <= rangeHi))
+    {
+        *pAllocLo = allocLo;
+        *pAllocAl = allocAl;
+        *pAllocHi = allocHi;
+        return NV_TRUE;
+    }
+
+    return NV_FALSE;
+}
+
+//
+// Find a free block for a non-fixed allocation using the size class lists.
+//
+// Blocks in classes below the request's can't hold it, and every block in a
+// class is smaller than any block in the classes above it.  So the first
+// fit by address is the best placed fitting block over all remaining
+// classes, and the best fit is the smallest fitting block in the lowest
+// class that has one.  Ties go to the lowest address, or the highest for
+// NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN, as with the address list walk.
+//
+static NvBool
+_eheapFindIndexedFreeBlock
+(
+    POBJEHEAP                 pHeap,
+    NvU32                     flags,
+    NvU64                     allocSize,
+    NvU64                     offsetAlign,
+    NvU64                     rangeLo,
+    NvU64                     rangeHi,
+    void                     *pIsolationID,
+    EHeapOwnershipComparator *checker,
+    PEMEMBLOCK               *pBlockFree,
+    NvU64                    *pAllocLo,
+    NvU64                    *pAllocAl,
+    NvU64                    *pAllocHi
+)
+{
+    NvBool     bGrowsDown = !!(flags & NVOS32_ALLOC_FLAGS_FORCE_MEM_GROWS_DOWN);
+    PEMEMBLOCK blockBest = NULL;
+    PEMEMBLOCK block;
+    NvU64      allocLo, allocAl, allocHi;
+    NvU32      sizeClass;
+
+    for (sizeClass = _eheapSizeClass(allocSize - 1);
+         sizeClass < EHEAP_NUM_SIZE_CLASSES;
+         sizeClass++)
+    {
+        for (block = pHeap->pSizeClassList[sizeClass];
+             block != NULL;
+             block = block->nextSizeFree)
+        {
+            if (blockBest != NULL)
+            {
+                NvBool bBetter;
+
+                if ((pHeap->allocPolicy == EHEAP_ALLOC_POLICY_BEST_FIT) &&
+                    ((block->end - block->begin) != (blockBest->end - blockBest->begin)))
+                {
+                    bBetter = (block->end - block->begin) < (blockBest->end - blockBest->begin);
+                }
+                else
+                {
+                    bBetter = bGrowsDown ? (block->begin > blockBest->begin) :
+                                           (block->begin < blockBest->begin);
+                }
+
+                if (!bBetter)
+                    continue;
+            }
+
+            if (_eheapFitFreeBlock(pHeap, block, flags, allocSize, offsetAlign,
+                                   rangeLo, rangeHi, pIsolationID, checker,
+                                   &allocLo, &allocAl, &allocHi))
+            {
+                blockBest  = block;
+                *pAllocLo  = allocLo;
+                *pAllocAl  = allocAl;
+                *pAllocHi  = allocHi;
+            }
+        }
+
+        if ((blockBest != NULL) && (pHeap->allocPolicy == EHEAP_ALLOC_POLICY_BEST_FIT))
+            break;
+    }
+
+    *pBlockFree = blockBest;
+
+    return (blockBest != NULL);
+}
+
 static NV_STATUS
 _eheapBlockFree
 (
@@ -887,6 +1119,7 @@ _eheapBlockFree
         //
         // Merge with previous block.
         //
+        _eheapSizeClassRemove(pHeap, block->prev);
         block->prev->next = block->next;
         block->next->prev = block->prev;
         block->prev->end  = block->end;
@@ -920,6 +1153,7 @@ _eheapBlockFree
         //
         // Merge with next block.
         //
+        _eheapSizeClassRemove(pHeap, block->next);
         block->prev->next    = block->next;
         block->next->prev    = block->prev;
         block->next->begin   = block->begin;
@@ -984,6 +1218,7 @@ _eheapBlockFree
     block->owner   = NVOS32_BLOCK_TYPE_FREE;
     //block->mhandle = 0x0;
     block->align   = block->begin;
+    _eheapSizeClassInsert(pHeap, block);
 
     portMemSet((block+1), 0, pHeap->sizeofMemBlock - sizeof(EMEMBLOCK));
 
@@ -45,6 +45,201 @@ Dynamic *fullyDeriveWrapper(Dynamic *pDynamic)
 
 const struct NVOC_RTTI_PROVIDER __nvoc_rtti_provider = { 0 };
 
+//
+// Per-class lookup tables.
+//
+// The first time a class is looked up, its relatives are flattened into an
+// open-addressed cast table keyed by class ID, and the export tables of all
+// relatives are merged into one array sorted by method ID.  Dynamic casts and
+// exported method lookups then no longer walk every relative in turn.
+//
+// The tables hang off a fixed size hash of class definitions.  Slots are
+// claimed with a CAS and the table pointer is published once it is complete,
+// so lookups never take a lock.  If a table cannot be built (no memory, or
+// unsafe to allocate), lookups fall back to scanning the relatives.
+//
+#define NVOC_LOOKUP_CLASSES_LOG2    8
+#define NVOC_LOOKUP_CLASSES         (1 << NVOC_LOOKUP_CLASSES_LOG2)
+
+struct NVOC_CAST_SLOT
+{
+    NVOC_CLASS_ID           classId;
+    const struct NVOC_RTTI *pRtti;                // NULL for an empty slot
+};
+
+struct NVOC_CLASS_LOOKUP
+{
+    NvU32                                   castLog2;
+    NvU32                                   castMask;
+    NvU32                                   numMethods;
+    const struct NVOC_EXPORTED_METHOD_DEF **ppMethods;    // sorted by methodId
+    struct NVOC_CAST_SLOT                   castSlots[];
+};
+
+static struct
+{
+    const struct NVOC_CLASS_DEF *volatile   pClassDef;
+    struct NVOC_CLASS_LOOKUP *volatile      pLookup;
+} __nvoc_lookupCache[NVOC_LOOKUP_CLASSES];
+
+static volatile NvU32 __nvoc_lookupCacheEnabled;
+
+static NV_FORCEINLINE NvU32 __nvoc_lookupHash(NvU64 key, NvU32 log2)
+{
+    return (NvU32)((key * 0x9E3779B97F4A7C15ULL) >> (64 - log2));
+}
+
+static struct NVOC_CLASS_LOOKUP *__nvoc_lookupBuild(const struct NVOC_CLASS_DEF *pClassDef)
+{
+    const struct NVOC_CASTINFO *pCastInfo = pClassDef->pCastInfo;
+    struct NVOC_CLASS_LOOKUP *pLookup;
+    NvU32 castLog2 = 1;
+    NvU32 maxMethods = 0;
+    NvU32 i, j;
+
+    // Keep the cast table at most half full
+    while ((1u << castLog2) < 2 * pCastInfo->numRelatives)
+        castLog2++;
+
+    for (i = 0; i < pCastInfo->numRelatives; i++)
+    {
+        const struct NVOC_EXPORT_INFO *pExportInfo = pCastInfo->relatives[i]->pClassDef->pExportInfo;
+        if (pExportInfo->pExportEntries != NULL)
+            maxMethods += pExportInfo->numEntries;
+    }
+
+    pLookup = portMemAllocNonPaged(sizeof(*pLookup) +
+                                   (sizeof(struct NVOC_CAST_SLOT) << castLog2) +
+                                   sizeof(pLookup->ppMethods[0]) * maxMethods);
+    if (pLookup == NULL)
+        return NULL;
+
+    portMemSet(pLookup, 0, sizeof(*pLookup) + (sizeof(struct NVOC_CAST_SLOT) << castLog2));
+    pLookup->castLog2 = castLog2;
+    pLookup->castMask = (1u << castLog2) - 1;
+    pLookup->ppMethods = (const struct NVOC_EXPORTED_METHOD_DEF **)&pLookup->castSlots[1u << castLog2];
+
+    for (i = 0; i < pCastInfo->numRelatives; i++)
+    {
+        const struct NVOC_RTTI *pRtti = pCastInfo->relatives[i];
+        NVOC_CLASS_ID classId = pRtti->pClassDef->classInfo.classId;
+
+        j = __nvoc_lookupHash(classId, castLog2);
+        while (pLookup->castSlots[j].pRtti != NULL)
+            j = (j + 1) & pLookup->castMask;
+
+        pLookup->castSlots[j].classId = classId;
+        pLookup->castSlots[j].pRtti   = pRtti;
+    }
+
+    //
+    // Merge the export tables with an insertion sort.  Relatives are ordered
+    // most derived first, and the first definition of a method ID wins, as it
+    // did when each relative was searched in turn.
+    //
+    for (i = 0; i < pCastInfo->numRelatives; i++)
+    {
+        const struct NVOC_EXPORT_INFO *pExportInfo = pCastInfo->relatives[i]->pClassDef->pExportInfo;
+        const struct NVOC_EXPORTED_METHOD_DEF *pEntries = pExportInfo->pExportEntries;
+        NvU32 k;
+
+        if (pEntries == NULL)
+            continue;
+
+        for (k = 0; k < pExportInfo->numEntries; k++)
+        {
+            NvU32 methodId = pEntries[k].methodId;
+
+            j = pLookup->numMethods;
+            while ((j > 0) && (pLookup->ppMethods[j - 1]->methodId > methodId))
+                j--;
+
+            if ((j > 0) && (pLookup->ppMethods[j - 1]->methodId == methodId))
+                continue;
+
+            portMemMove(&pLookup->ppMethods[j + 1],
+                        sizeof(pLookup->ppMethods[0]) * (pLookup->numMethods - j),
+                        &pLookup->ppMethods[j],
+                        sizeof(pLookup->ppMethods[0]) * (pLookup->numMethods - j));
+            pLookup->ppMethods[j] = &pEntries[k];
+            pLookup->numMethods++;
+        }
+    }
+
+    return pLookup;
+}
+
+static const struct NVOC_CLASS_LOOKUP *__nvoc_lookupGet(const struct NVOC_CLASS_DEF *pClassDef)
+{
+    NvU32 idx = __nvoc_lookupHash((NvU64)(NvUPtr)pClassDef, NVOC_LOOKUP_CLASSES_LOG2);
+    NvU32 probe;
+
+    if (!__nvoc_lookupCacheEnabled)
+        return NULL;
+
+    for (probe = 0; probe < NVOC_LOOKUP_CLASSES; probe++)
+    {
+        NvU32 slot = (idx + probe) & (NVOC_LOOKUP_CLASSES - 1);
+        const struct NVOC_CLASS_DEF *pSlotClassDef = __nvoc_lookupCache[slot].pClassDef;
+        struct NVOC_CLASS_LOOKUP *pLookup;
+
+        if (pSlotClassDef == pClassDef)
+        {
+            // NULL while another thread is still building it
+            return __nvoc_lookupCache[slot].pLookup;
+        }
+
+        if (pSlotClassDef != NULL)
+            continue;
+
+#if portMemExSafeForNonPagedAlloc_SUPPORTED
+        if (!portMemExSafeForNonPagedAlloc())
+            return NULL;
+#endif
+
+        if (!portAtomicCompareAndSwapSize(&__nvoc_lookupCache[slot].pClassDef, pClassDef, NULL))
+        {
+            // Lost the race for this slot; look at it again
+            probe--;
+            continue;
+        }
+
+        pLookup = __nvoc_lookupBuild(pClassDef);
+        if (pLookup != NULL)
+        {
+            portAtomicMemoryFenceStore();
+            __nvoc_lookupCache[slot].pLookup = pLookup;
+        }
+        return pLookup;
+    }
+
+    return NULL;
+}
+
+void __nvoc_lookupCacheInit(void)
+{
+    portMemSet((void *)__nvoc_lookupCache, 0, sizeof(__nvoc_lookupCache));
+    portAtomicMemoryFenceStore();
+    __nvoc_lookupCacheEnabled = NV_TRUE;
+}
+
+void __nvoc_lookupCacheDestroy(void)
+{
+    NvU32 i;
+
+    __nvoc_lookupCacheEnabled = NV_FALSE;
+    portAtomicMemoryFenceFull();
+
+    for (i = 0; i < NVOC_LOOKUP_CLASSES; i++)
+    {
+        if (__nvoc_lookupCache[i].pLookup != NULL)
+            portMemFree(__nvoc_lookupCache[i].pLookup);
+
+        __nvoc_lookupCache[i].pLookup = NULL;
+        __nvoc_lookupCache[i].pClassDef = NULL;
+    }
+}
+
 NVOC_CLASS_ID __nvoc_objGetClassId(Dynamic *pObj)
 {
     Dynamic *pDerivedObj = __nvoc_fullyDerive(pObj);
@@ -191,6 +386,7 @@ Dynamic *objDynamicCastById_IMPL(Dynamic *pFromObj, NVOC_CLASS_ID classId)
     const struct NVOC_RTTI *const   *bases;
     const struct NVOC_RTTI          *pFromRtti;
     const struct NVOC_RTTI          *pDerivedRtti;
+    const struct NVOC_CLASS_LOOKUP  *pLookup;
 
     if (pFromObj == NULL)
     {
@@ -214,6 +410,19 @@ Dynamic *objDynamicCastById_IMPL(Dynamic *pFromObj, NVOC_CLASS_ID classId)
         return pDerivedObj;
     }
 
+    pLookup = __nvoc_lookupGet(pDerivedRtti->pClassDef);
+    if (pLookup != NULL)
+    {
+        i = __nvoc_lookupHash(classId, pLookup->castLog2);
+        while (pLookup->castSlots[i].pRtti != NULL)
+        {
+            if (pLookup->castSlots[i].classId == classId)
+                return (Dynamic*)((NvU8*)pDerivedObj + pLookup->castSlots[i].pRtti->offset);
+            i = (i + 1) & pLookup->castMask;
+        }
+        return NULL;
+    }
+
     // slowpath, search all the possibilities for a match
     numBases = pDerivedRtti->pClassDef->pCastInfo->numRelatives;
     bases = pDerivedRtti->pClassDef->pCastInfo->relatives;
@@ -253,8 +462,29 @@ const struct NVOC_EXPORTED_METHOD_DEF *objGetExportedMethodDef_IMPL(Dynamic *pOb
     const struct NVOC_CASTINFO *const pCastInfo = pObj->__nvoc_rtti->pClassDef->pCastInfo;
     const NvU32 numRelatives = pCastInfo->numRelatives;
     const struct NVOC_RTTI *const *relatives = pCastInfo->relatives;
+    const struct NVOC_CLASS_LOOKUP *pLookup = __nvoc_lookupGet(pObj->__nvoc_rtti->pClassDef);
     NvU32 i;
 
+    if (pLookup != NULL)
+    {
+        // Merged table of all relatives, sorted by methodId
+        NvU32 low = 0;
+        NvU32 high = pLookup->numMethods;
+        while (low < high)
+        {
+            NvU32 mid = (low + high) / 2;
+            NvU32 midId = pLookup->ppMethods[mid]->methodId;
+
+            if (midId == methodId)
+                return pLookup->ppMethods[mid];
+
+            if (midId > methodId)
+                high = mid;
+            else
+                low = mid + 1;
+        }
+        return NULL;
+    }
 
     for (i = 0; i < numRelatives; i++)
     {
@@ -44,6 +44,52 @@ struct PORT_MEM_ALLOCATOR_IMPL
     PORT_MEM_ALLOCATOR_TRACKING tracking;
 };
 
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+//
+// Object cache allocator internals.
+//
+// Size classes are powers of 2 from 16 bytes up to PORT_MEM_OBJECT_CACHE_MAX_SIZE.
+// Free lists are striped by a hash of the current thread id, since NvPort has
+// no notion of the current CPU; a thread allocating and freeing its own nodes
+// keeps hitting the same stripe.
+//
+#define PORT_MEM_OBJECT_CACHE_MIN_SHIFT     4
+#define PORT_MEM_OBJECT_CACHE_NUM_CLASSES   6
+#define PORT_MEM_OBJECT_CACHE_STRIPES_LOG2  4
+#define PORT_MEM_OBJECT_CACHE_NUM_STRIPES   (1 << PORT_MEM_OBJECT_CACHE_STRIPES_LOG2)
+// Maximum number of idle objects kept per size class in each stripe
+#define PORT_MEM_OBJECT_CACHE_STRIPE_DEPTH  64
+
+#if (1 << (PORT_MEM_OBJECT_CACHE_MIN_SHIFT + PORT_MEM_OBJECT_CACHE_NUM_CLASSES - 1)) != PORT_MEM_OBJECT_CACHE_MAX_SIZE
+#error "Object cache size classes do not match PORT_MEM_OBJECT_CACHE_MAX_SIZE"
+#endif
+
+// Prepended to every object; keeps the object 16-byte aligned.
+typedef union PORT_MEM_OBJECT_CACHE_HEADER
+{
+    /// Size class, or PORT_MEM_OBJECT_CACHE_NUM_CLASSES for uncached sizes
+    NvU32 sizeClass;
+    NvU64 align[2];
+} PORT_MEM_OBJECT_CACHE_HEADER;
+
+typedef struct PORT_MEM_OBJECT_CACHE_STRIPE
+{
+    void *pLock;
+    /// Singly linked free lists, linked through the first word of each object
+    void *pFree[PORT_MEM_OBJECT_CACHE_NUM_CLASSES];
+    NvU32 numFree[PORT_MEM_OBJECT_CACHE_NUM_CLASSES];
+} PORT_MEM_OBJECT_CACHE_STRIPE;
+
+typedef struct PORT_MEM_OBJECT_CACHE
+{
+    PORT_MEM_OBJECT_CACHE_STRIPE stripes[PORT_MEM_OBJECT_CACHE_NUM_STRIPES];
+} PORT_MEM_OBJECT_CACHE;
+
+// Object cache is placed right after the allocator's tracking structure.
+#define _portMemObjectCacheGet(pAlloc) \
+    ((PORT_MEM_OBJECT_CACHE*)((pAlloc)->pImpl + 1))
+#endif
+
 //
 // Debug print macros
 //
@@ -256,7 +302,7 @@ _portMemFenceCheck
 static NV_INLINE void
 _portMemListAdd
 (
-    PORT_MEM_ALLOCATOR_TRACKING *pTracking,
+    PORT_MEM_TRACK_STRIPE       *pTracking,
     void                        *pMem
 )
 {
@@ -272,7 +318,7 @@ _portMemListAdd
 static NV_INLINE void
 _portMemListRemove
 (
-    PORT_MEM_ALLOCATOR_TRACKING *pTracking,
+    PORT_MEM_TRACK_STRIPE       *pTracking,
     void                        *pMem
 )
 {
@@ -301,7 +347,7 @@ _portMemListGetHeader
     } while (0)
 #define PORT_MEM_LIST_DESTROY(pTracking)   PORT_MEM_LOCK_DESTROY((pTracking)->listLock)
 #define PORT_MEM_LIST_ADD(pTracking, pMem)   _portMemListAdd(pTracking, pMem)
-#define PORT_MEM_LIST_REMOVE(Tracking, pMem) _portMemListRemove(pTracking, pMem)
+#define PORT_MEM_LIST_REMOVE(pTracking, pMem) _portMemListRemove(pTracking, pMem)
 #else
 #define PORT_MEM_LIST_INIT(x)
 #define PORT_MEM_LIST_DESTROY(x)
@@ -310,6 +356,86 @@ _portMemListGetHeader
 #endif // ALLOCLIST
 
 
+//
+// Tracking stripes implementation
+//
+#if PORT_MEM_TRACK_USE_STRIPES
+static NV_INLINE NvU32
+_portMemStripeSelect(void)
+{
+#if PORT_IS_MODULE_SUPPORTED(thread)
+    NvU64 hash = portThreadGetCurrentThreadId() * 0x9E3779B97F4A7C15ULL;
+    return (NvU32)(hash >> (64 - PORT_MEM_TRACK_STRIPES_LOG2));
+#else
+    return 0;
+#endif
+}
+// The stripe is recorded so the free is accounted where the allocation was.
+#define PORT_MEM_STRIPE_SELECT()          _portMemStripeSelect()
+#define PORT_MEM_STRIPE_INIT(pMem, idx)   (((PORT_MEM_HEADER*)(pMem) - 1)->stripe = (idx))
+#define PORT_MEM_STRIPE_GET(pMem)         ((NvU32)((PORT_MEM_HEADER*)(pMem) - 1)->stripe)
+#else
+#define PORT_MEM_STRIPE_SELECT()          0
+#define PORT_MEM_STRIPE_INIT(pMem, idx)
+#define PORT_MEM_STRIPE_GET(pMem)         0
+#endif // STRIPES
+
+static NV_INLINE void
+_portMemTrackingStripesInit
+(
+    PORT_MEM_ALLOCATOR_TRACKING *pTracking
+)
+{
+    NvU32 i;
+    for (i = 0; i < PORT_MEM_TRACK_NUM_STRIPES; i++)
+    {
+        PORT_MEM_COUNTER_INIT(&pTracking->stripes[i].counter);
+        PORT_MEM_LIST_INIT(&pTracking->stripes[i]);
+    }
+}
+
+static NV_INLINE void
+_portMemTrackingStripesDestroy
+(
+    PORT_MEM_ALLOCATOR_TRACKING *pTracking
+)
+{
+    NvU32 i;
+    for (i = 0; i < PORT_MEM_TRACK_NUM_STRIPES; i++)
+    {
+        PORT_MEM_LIST_DESTROY(&pTracking->stripes[i]);
+    }
+}
+
+#if PORT_MEM_TRACK_USE_COUNTER
+//
+// Sums the counters of all stripes. Individual fields are read without a lock,
+// so the result is a snapshot that may be slightly out of date.
+//
+static void
+_portMemTrackingGetCounter
+(
+    const PORT_MEM_ALLOCATOR_TRACKING *pTracking,
+    PORT_MEM_COUNTER                  *pCounter
+)
+{
+    NvU32 i;
+
+    portMemSet(pCounter, 0, sizeof(*pCounter));
+    for (i = 0; i < PORT_MEM_TRACK_NUM_STRIPES; i++)
+    {
+        const PORT_MEM_COUNTER *pStripe = &pTracking->stripes[i].counter;
+        pCounter->activeAllocs += pStripe->activeAllocs;
+        pCounter->totalAllocs  += pStripe->totalAllocs;
+        pCounter->peakAllocs   += pStripe->peakAllocs;
+        pCounter->activeSize   += pStripe->activeSize;
+        pCounter->totalSize    += pStripe->totalSize;
+        pCounter->peakSize     += pStripe->peakSize;
+    }
+}
+#endif // COUNTER
+
+
 
 //
 // Memory allocation-caller info implementation
@@ -443,6 +569,15 @@ static PORT_MEM_ALLOCATOR *_portMemAllocatorCreateOnExistingBlock(void *pAlloc,
 static void    *_portMemAllocatorAllocExistingWrapper(PORT_MEM_ALLOCATOR *pAlloc, NvLength length);
 static void     _portMemAllocatorFreeExistingWrapper(PORT_MEM_ALLOCATOR *pAlloc, void *pMem);
 
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+static void    *_portMemAllocatorAllocObjectCacheWrapper(PORT_MEM_ALLOCATOR *pAlloc, NvLength length);
+static void     _portMemAllocatorFreeObjectCacheWrapper(PORT_MEM_ALLOCATOR *pAlloc, void *pMem);
+static void     _portMemAllocatorReleaseObjectCacheWrapper(PORT_MEM_ALLOCATOR *pAlloc);
+#if PORT_MEM_TRACK_USE_COUNTER
+static NvLength _portMemObjectCacheCachedSize(const PORT_MEM_ALLOCATOR *pAlloc);
+#endif
+#endif
+
 static void _portMemTrackingRelease(PORT_MEM_ALLOCATOR_TRACKING *pTracking);
 static void _portMemTrackAlloc(PORT_MEM_ALLOCATOR_TRACKING *pTracking, void *pMem, NvLength size PORT_MEM_CALLERINFO_COMMA_TYPE_PARAM);
 static void _portMemTrackFree(PORT_MEM_ALLOCATOR_TRACKING *pTracking, void *pMem);
@@ -458,6 +593,7 @@ static void _portMemTrackFree(PORT_MEM_ALLOCATOR_TRACKING *pTracking, void *pMem
 #undef _portMemAllocatorAlloc
 #undef portMemAllocatorCreateOnExistingBlock
 #undef portMemExAllocatorCreateLockedOnExistingBlock
+#undef portMemExAllocatorCreateObjectCache
 // These functions have different names if CallerInfo is enabled.
 #define portMemAllocPaged              portMemAllocPaged_CallerInfo
 #define portMemAllocNonPaged           portMemAllocNonPaged_CallerInfo
@@ -467,6 +603,7 @@ static void _portMemTrackFree(PORT_MEM_ALLOCATOR_TRACKING *pTracking, void *pMem
 #define _portMemAllocatorAlloc         _portMemAllocatorAlloc_CallerInfo
 #define portMemAllocatorCreateOnExistingBlock portMemAllocatorCreateOnExistingBlock_CallerInfo
 #define portMemExAllocatorCreateLockedOnExistingBlock portMemExAllocatorCreateLockedOnExistingBlock_CallerInfo
+#define portMemExAllocatorCreateObjectCache portMemExAllocatorCreateObjectCache_CallerInfo
 #endif
 
 //
@@ -512,8 +649,7 @@ portMemInitialize(void)
     portMemGlobals.mainTracking.pAllocator = NULL;
     portMemGlobals.mainTracking.pNext = &portMemGlobals.mainTracking;
     portMemGlobals.mainTracking.pPrev = &portMemGlobals.mainTracking;
-    PORT_MEM_COUNTER_INIT(&portMemGlobals.mainTracking.counter);
-    PORT_MEM_LIST_INIT(&portMemGlobals.mainTracking);
+    _portMemTrackingStripesInit(&portMemGlobals.mainTracking);
     PORT_MEM_LOCK_INIT(portMemGlobals.trackingLock);
 
     portMemGlobals.alloc.paged._portAlloc      = _portMemAllocatorAllocPagedWrapper;
@@ -574,7 +710,7 @@ portMemShutdown(NvBool bForceSilent)
     }
 
     PORT_MEM_LOCK_DESTROY(portMemGlobals.trackingLock);
-    PORT_MEM_LIST_DESTROY(&portMemGlobals.mainTracking);
+    _portMemTrackingStripesDestroy(&portMemGlobals.mainTracking);
     portMemSet(&portMemGlobals, 0, sizeof(portMemGlobals));
 }
 
@@ -694,6 +830,48 @@ portMemExAllocatorCreateLockedOnExistingBlock
                                                   pSpinlock);
 }
 
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+PORT_MEM_ALLOCATOR *
+portMemExAllocatorCreateObjectCache(PORT_MEM_CALLERINFO_TYPE_PARAM)
+{
+    PORT_MEM_ALLOCATOR *pAllocator;
+    PORT_MEM_OBJECT_CACHE *pCache;
+    NvU32 i;
+
+    pAllocator = _portMemAllocNonPagedUntracked(PORT_MEM_ALLOCATOR_SIZE +
+                                                sizeof(PORT_MEM_OBJECT_CACHE));
+    if (pAllocator == NULL)
+        return NULL;
+
+    portMemSet(pAllocator, 0, PORT_MEM_ALLOCATOR_SIZE + sizeof(PORT_MEM_OBJECT_CACHE));
+
+    pAllocator->pImpl         = (PORT_MEM_ALLOCATOR_IMPL*)(pAllocator + 1);
+    pAllocator->_portAlloc    = _portMemAllocatorAllocObjectCacheWrapper;
+    pAllocator->_portFree     = _portMemAllocatorFreeObjectCacheWrapper;
+    pAllocator->_portRelease  = _portMemAllocatorReleaseObjectCacheWrapper;
+
+    pCache = _portMemObjectCacheGet(pAllocator);
+    for (i = 0; i < PORT_MEM_OBJECT_CACHE_NUM_STRIPES; i++)
+    {
+        PORT_MEM_LOCK_INIT(pCache->stripes[i].pLock);
+        if (pCache->stripes[i].pLock == NULL)
+        {
+            while (i-- > 0)
+                PORT_MEM_LOCK_DESTROY(pCache->stripes[i].pLock);
+            _portMemFreeUntracked(pAllocator);
+            return NULL;
+        }
+    }
+
+    portMemInitializeAllocatorTracking(pAllocator, &pAllocator->pImpl->tracking
+                                       PORT_MEM_CALLERINFO_COMMA_PARAM);
+
+    PORT_MEM_PRINT_INFO("Acquired object cache allocator %p", pAllocator);
+    PORT_MEM_PRINT_INFO(PORT_MEM_CALLERINFO_PRINT_ARGS(PORT_MEM_CALLERINFO_PARAM));
+    return pAllocator;
+}
+#endif
+
 void
 portMemAllocatorRelease
 (
@@ -744,8 +922,7 @@ portMemInitializeAllocatorTracking
     if (pAlloc != NULL)
         pAlloc->pTracking = pTracking;
     PORT_LOCKED_LIST_LINK(&portMemGlobals.mainTracking, pTracking, portMemGlobals.trackingLock);
-    PORT_MEM_COUNTER_INIT(&pTracking->counter);
-    PORT_MEM_LIST_INIT(pTracking);
+    _portMemTrackingStripesInit(pTracking);
     PORT_MEM_CALLERINFO_INIT_TRACKING(pTracking);
     portAtomicIncrementU32(&portMemGlobals.totalAllocators);
 }
@@ -867,6 +1044,11 @@ portMemPrintTrackingInfo
                         (NvU64) stats.allocatedSize,
                         (NvU64) stats.usefulSize,
                         (NvU64) stats.metaSize);
+            if (stats.cachedSize != 0)
+            {
+                portDbgPrintf("CACHED: %llu bytes held for reuse\n",
+                            (NvU64) stats.cachedSize);
+            }
         }
 #endif
 
@@ -947,14 +1129,35 @@ portMemExTrackingGetActiveStats
 )
 {
     PORT_MEM_ALLOCATOR_TRACKING *pTracking = _portMemGetTracking(pAllocator);
+    PORT_MEM_COUNTER counter;
     if (pTracking == NULL)
     {
         return NV_ERR_OBJECT_NOT_FOUND;
     }
-    pStats->numAllocations = pTracking->counter.activeAllocs;
-    pStats->usefulSize     = pTracking->counter.activeSize;
+    _portMemTrackingGetCounter(pTracking, &counter);
+    pStats->numAllocations = counter.activeAllocs;
+    pStats->usefulSize     = counter.activeSize;
     pStats->metaSize       = pStats->numAllocations * PORT_MEM_STAGING_SIZE;
     pStats->allocatedSize  = pStats->usefulSize + pStats->metaSize;
+    pStats->cachedSize     = 0;
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+    if (pAllocator != NULL)
+    {
+        pStats->cachedSize = _portMemObjectCacheCachedSize(pAllocator);
+    }
+    else
+    {
+        PORT_MEM_LOCK_ACQUIRE(portMemGlobals.trackingLock);
+        for (pTracking = portMemGlobals.mainTracking.pNext;
+             pTracking != &portMemGlobals.mainTracking;
+             pTracking = pTracking->pNext)
+        {
+            if (pTracking->pAllocator != NULL)
+                pStats->cachedSize += _portMemObjectCacheCachedSize(pTracking->pAllocator);
+        }
+        PORT_MEM_LOCK_RELEASE(portMemGlobals.trackingLock);
+    }
+#endif
     return NV_OK;
 }
 #endif
@@ -968,14 +1171,17 @@ portMemExTrackingGetTotalStats
 )
 {
     PORT_MEM_ALLOCATOR_TRACKING *pTracking = _portMemGetTracking(pAllocator);
+    PORT_MEM_COUNTER counter;
     if (pTracking == NULL)
     {
         return NV_ERR_OBJECT_NOT_FOUND;
     }
-    pStats->numAllocations = pTracking->counter.totalAllocs;
-    pStats->usefulSize     = pTracking->counter.totalSize;
+    _portMemTrackingGetCounter(pTracking, &counter);
+    pStats->numAllocations = counter.totalAllocs;
+    pStats->usefulSize     = counter.totalSize;
     pStats->metaSize       = pStats->numAllocations * PORT_MEM_STAGING_SIZE;
     pStats->allocatedSize  = pStats->usefulSize + pStats->metaSize;
+    pStats->cachedSize     = 0;
     return NV_OK;
 }
 #endif
@@ -989,14 +1195,17 @@ portMemExTrackingGetPeakStats
 )
 {
     PORT_MEM_ALLOCATOR_TRACKING *pTracking = _portMemGetTracking(pAllocator);
+    PORT_MEM_COUNTER counter;
     if (pTracking == NULL)
     {
         return NV_ERR_OBJECT_NOT_FOUND;
     }
-    pStats->numAllocations = pTracking->counter.peakAllocs;
-    pStats->usefulSize     = pTracking->counter.peakSize;
+    _portMemTrackingGetCounter(pTracking, &counter);
+    pStats->numAllocations = counter.peakAllocs;
+    pStats->usefulSize     = counter.peakSize;
     pStats->metaSize       = pStats->numAllocations * PORT_MEM_STAGING_SIZE;
     pStats->allocatedSize  = pStats->usefulSize + pStats->metaSize;
+    pStats->cachedSize     = 0;
     return NV_OK;
 }
 #endif
@@ -1011,29 +1220,51 @@ portMemExTrackingGetNext
 )
 {
     PORT_MEM_ALLOCATOR_TRACKING *pTracking = _portMemGetTracking(pAllocator);
-    PORT_MEM_LIST *pList;
+    PORT_MEM_LIST *pList = NULL;
     PORT_MEM_HEADER *pHead;
+    NvU32 stripe;
 
     if (pTracking == NULL)
     {
         return NV_ERR_OBJECT_NOT_FOUND;
     }
 
-    if (pTracking->pFirstAlloc == NULL)
-        return NV_ERR_OBJECT_NOT_FOUND;
-
     if (*pIterator == NULL)
-        pList = pTracking->pFirstAlloc;
+    {
+        for (stripe = 0; stripe < PORT_MEM_TRACK_NUM_STRIPES; stripe++)
+        {
+            pList = pTracking->stripes[stripe].pFirstAlloc;
+            if (pList != NULL)
+                break;
+        }
+        if (pList == NULL)
+            return NV_ERR_OBJECT_NOT_FOUND;
+    }
     else
+    {
         pList = (PORT_MEM_LIST*)(*pIterator);
+    }
 
     pHead = _portMemListGetHeader(pList);
+    stripe = PORT_MEM_STRIPE_GET(pHead + 1);
 
-    // Advance itertator
-    if (pList->pNext == pTracking->pFirstAlloc)
-        *pIterator = NULL;
-    else
+    // Advance itertator, moving on to the next non-empty stripe at the end
+    if (pList->pNext != pTracking->stripes[stripe].pFirstAlloc)
+    {
         *pIterator = pList->pNext;
+    }
+    else
+    {
+        *pIterator = NULL;
+        while (++stripe < PORT_MEM_TRACK_NUM_STRIPES)
+        {
+            if (pTracking->stripes[stripe].pFirstAlloc != NULL)
+            {
+                *pIterator = pTracking->stripes[stripe].pFirstAlloc;
+                break;
+            }
+        }
+    }
 
     // Populate pInfo
     pInfo->pMemory    = pHead + 1;
@@ -1057,16 +1288,22 @@ _portMemTrackingRelease
 {
     if (pTracking == NULL) return;
 
-    if (pTracking->counter.activeAllocs != 0)
+#if PORT_MEM_TRACK_USE_COUNTER
     {
-        PORT_MEM_PRINT_ERROR("Allocator %p released with memory allocations\n", pTracking->pAllocator);
+        PORT_MEM_COUNTER counter;
+        _portMemTrackingGetCounter(pTracking, &counter);
+        if (counter.activeAllocs != 0)
+        {
+            PORT_MEM_PRINT_ERROR("Allocator %p released with memory allocations\n", pTracking->pAllocator);
 #if (PORT_MEM_TRACK_PRINT_LEVEL > PORT_MEM_TRACK_PRINT_LEVEL_SILENT)
-        portMemPrintTrackingInfo(pTracking->pAllocator);
+            portMemPrintTrackingInfo(pTracking->pAllocator);
 #endif
+        }
     }
+#endif
 
     PORT_LOCKED_LIST_UNLINK(&portMemGlobals.mainTracking, pTracking, portMemGlobals.trackingLock);
-    PORT_MEM_LIST_DESTROY(pTracking);
+    _portMemTrackingStripesDestroy(pTracking);
     portAtomicDecrementU32(&portMemGlobals.totalAllocators);
 }
 
@@ -1079,16 +1316,22 @@ _portMemTrackAlloc
     PORT_MEM_CALLERINFO_COMMA_TYPE_PARAM
 )
 {
+    NvU32 stripe;
+
     PORT_UNREFERENCED_VARIABLE(pMem);
     if (pTracking == NULL) return;
     PORT_MEM_PRINT_INFO("Allocating %u bytes at address %p", size, pMem);
     PORT_MEM_PRINT_INFO(PORT_MEM_CALLERINFO_PRINT_ARGS(PORT_MEM_CALLERINFO_PARAM));
 
-    PORT_MEM_COUNTER_INC(&pTracking->counter, size);
-    PORT_MEM_COUNTER_INC(&portMemGlobals.mainTracking.counter, size);
+    stripe = PORT_MEM_STRIPE_SELECT();
+    PORT_UNREFERENCED_VARIABLE(stripe);
+    PORT_MEM_STRIPE_INIT(pMem, stripe);
+
+    PORT_MEM_COUNTER_INC(&pTracking->stripes[stripe].counter, size);
+    PORT_MEM_COUNTER_INC(&portMemGlobals.mainTracking.stripes[stripe].counter, size);
 
     PORT_MEM_FENCE_INIT(pTracking->pAllocator, pMem, size);
-    PORT_MEM_LIST_ADD(pTracking, pMem);
+    PORT_MEM_LIST_ADD(&pTracking->stripes[stripe], pMem);
     PORT_MEM_CALLERINFO_INIT_MEM(pMem);
     PORT_MEM_LOG_ALLOC(pTracking->pAllocator, pMem, size);
 }
@@ -1100,14 +1343,19 @@ _portMemTrackFree
     void                        *pMem
 )
 {
+    NvU32 stripe;
+
     if (pTracking == NULL) return;
     PORT_MEM_PRINT_INFO("Freeing block at address %p\n", pMem);
 
-    PORT_MEM_COUNTER_DEC(&pTracking->counter, pMem);
-    PORT_MEM_COUNTER_DEC(&portMemGlobals.mainTracking.counter, pMem);
+    stripe = PORT_MEM_STRIPE_GET(pMem);
+    PORT_UNREFERENCED_VARIABLE(stripe);
+
+    PORT_MEM_COUNTER_DEC(&pTracking->stripes[stripe].counter, pMem);
+    PORT_MEM_COUNTER_DEC(&portMemGlobals.mainTracking.stripes[stripe].counter, pMem);
 
     PORT_MEM_FENCE_CHECK(pTracking->pAllocator, pMem);
-    PORT_MEM_LIST_REMOVE(pTracking, pMem);
+    PORT_MEM_LIST_REMOVE(&pTracking->stripes[stripe], pMem);
     PORT_MEM_LOG_FREE(pTracking->pAllocator, pMem);
 }
 
@@ -1337,3 +1585,153 @@ _portMemAllocatorFreeExistingWrapper
         portSyncSpinlockRelease(pSpinlock);
     }
 }
+
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+static NV_INLINE PORT_MEM_OBJECT_CACHE_STRIPE *
+_portMemObjectCacheStripeGet
+(
+    PORT_MEM_OBJECT_CACHE *pCache
+)
+{
+#if PORT_IS_MODULE_SUPPORTED(thread)
+    NvU64 hash = portThreadGetCurrentThreadId() * 0x9E3779B97F4A7C15ULL;
+    return &pCache->stripes[hash >> (64 - PORT_MEM_OBJECT_CACHE_STRIPES_LOG2)];
+#else
+    return &pCache->stripes[0];
+#endif
+}
+
+static void *
+_portMemAllocatorAllocObjectCacheWrapper
+(
+    PORT_MEM_ALLOCATOR *pAlloc,
+    NvLength length
+)
+{
+    PORT_MEM_OBJECT_CACHE_HEADER *pHeader = NULL;
+    NvU32 sizeClass = PORT_MEM_OBJECT_CACHE_NUM_CLASSES;
+
+    if (length <= PORT_MEM_OBJECT_CACHE_MAX_SIZE)
+    {
+        PORT_MEM_OBJECT_CACHE_STRIPE *pStripe;
+
+        sizeClass = (length <= (1U << PORT_MEM_OBJECT_CACHE_MIN_SHIFT)) ? 0 :
+            64 - (NvU32)portUtilCountLeadingZeros64((NvU64)length - 1) - PORT_MEM_OBJECT_CACHE_MIN_SHIFT;
+        length = (NvLength)1 << (sizeClass + PORT_MEM_OBJECT_CACHE_MIN_SHIFT);
+
+        pStripe = _portMemObjectCacheStripeGet(_portMemObjectCacheGet(pAlloc));
+        PORT_MEM_LOCK_ACQUIRE(pStripe->pLock);
+        if (pStripe->pFree[sizeClass] != NULL)
+        {
+            pHeader = (PORT_MEM_OBJECT_CACHE_HEADER*)pStripe->pFree[sizeClass] - 1;
+            pStripe->pFree[sizeClass] = *(void**)pStripe->pFree[sizeClass];
+            pStripe->numFree[sizeClass]--;
+        }
+        PORT_MEM_LOCK_RELEASE(pStripe->pLock);
+    }
+
+    if (pHeader == NULL)
+    {
+        NvLength allocLength;
+
+        if (!portSafeAddLength(length, sizeof(*pHeader), &allocLength))
+            return NULL;
+
+        pHeader = _portMemAllocNonPagedUntracked(allocLength);
+        if (pHeader == NULL)
+            return NULL;
+    }
+
+    pHeader->sizeClass = sizeClass;
+    return pHeader + 1;
+}
+
+static void
+_portMemAllocatorFreeObjectCacheWrapper
+(
+    PORT_MEM_ALLOCATOR *pAlloc,
+    void *pMem
+)
+{
+    PORT_MEM_OBJECT_CACHE_HEADER *pHeader = (PORT_MEM_OBJECT_CACHE_HEADER*)pMem - 1;
+    NvU32 sizeClass = pHeader->sizeClass;
+
+    if (sizeClass < PORT_MEM_OBJECT_CACHE_NUM_CLASSES)
+    {
+        PORT_MEM_OBJECT_CACHE_STRIPE *pStripe;
+
+        pStripe = _portMemObjectCacheStripeGet(_portMemObjectCacheGet(pAlloc));
+        PORT_MEM_LOCK_ACQUIRE(pStripe->pLock);
+        if (pStripe->numFree[sizeClass] < PORT_MEM_OBJECT_CACHE_STRIPE_DEPTH)
+        {
+            *(void**)pMem = pStripe->pFree[sizeClass];
+            pStripe->pFree[sizeClass] = pMem;
+            pStripe->numFree[sizeClass]++;
+            pHeader = NULL;
+        }
+        PORT_MEM_LOCK_RELEASE(pStripe->pLock);
+    }
+
+    if (pHeader != NULL)
+        _portMemFreeUntracked(pHeader);
+}
+
+static void
+_portMemAllocatorReleaseObjectCacheWrapper
+(
+    PORT_MEM_ALLOCATOR *pAllocator
+)
+{
+    PORT_MEM_OBJECT_CACHE *pCache = _portMemObjectCacheGet(pAllocator);
+    NvU32 i, j;
+
+    for (i = 0; i < PORT_MEM_OBJECT_CACHE_NUM_STRIPES; i++)
+    {
+        PORT_MEM_OBJECT_CACHE_STRIPE *pStripe = &pCache->stripes[i];
+
+        for (j = 0; j < PORT_MEM_OBJECT_CACHE_NUM_CLASSES; j++)
+        {
+            while (pStripe->pFree[j] != NULL)
+            {
+                void *pMem = pStripe->pFree[j];
+                pStripe->pFree[j] = *(void**)pMem;
+                _portMemFreeUntracked((PORT_MEM_OBJECT_CACHE_HEADER*)pMem - 1);
+            }
+        }
+        PORT_MEM_LOCK_DESTROY(pStripe->pLock);
+    }
+    _portMemFreeUntracked(pAllocator);
+}
+
+#if PORT_MEM_TRACK_USE_COUNTER
+static NvLength
+_portMemObjectCacheCachedSize
+(
+    const PORT_MEM_ALLOCATOR *pAlloc
+)
+{
+    PORT_MEM_OBJECT_CACHE *pCache;
+    NvLength cachedSize = 0;
+    NvU32 i, j;
+
+    if (pAlloc->_portAlloc != _portMemAllocatorAllocObjectCacheWrapper)
+        return 0;
+
+    pCache = _portMemObjectCacheGet(pAlloc);
+    for (i = 0; i < PORT_MEM_OBJECT_CACHE_NUM_STRIPES; i++)
+    {
+        PORT_MEM_OBJECT_CACHE_STRIPE *pStripe = &pCache->stripes[i];
+
+        PORT_MEM_LOCK_ACQUIRE(pStripe->pLock);
+        for (j = 0; j < PORT_MEM_OBJECT_CACHE_NUM_CLASSES; j++)
+        {
+            cachedSize += pStripe->numFree[j] *
+                (((NvLength)1 << (j + PORT_MEM_OBJECT_CACHE_MIN_SHIFT)) +
+                 sizeof(PORT_MEM_OBJECT_CACHE_HEADER));
+        }
+        PORT_MEM_LOCK_RELEASE(pStripe->pLock);
+    }
+    return cachedSize;
+}
+#endif // PORT_MEM_TRACK_USE_COUNTER
+#endif // portMemExAllocatorCreateObjectCache_SUPPORTED
@@ -978,7 +978,7 @@ _clientConstructResourceRef
     RsResourceRef **ppResourceRef
 )
 {
-    PORT_MEM_ALLOCATOR *pAllocator = pServer->pAllocator;
+    PORT_MEM_ALLOCATOR *pAllocator = pServer->pRefAllocator;
     RsResourceRef *pResourceRef = mapInsertNew(&pClient->resourceMap, hResource);
     if (pResourceRef == NULL)
         return NV_ERR_INSUFFICIENT_RESOURCES;
@@ -23,6 +23,7 @@
  
 #define NVOC_RS_SERVER_H_PRIVATE_ACCESS_ALLOWED
 #include "nvlog_inc.h"
+#include "nvctassert.h"
 #include "resserv/resserv.h"
 #include "resserv/rs_server.h"
 #include "resserv/rs_client.h"
@@ -35,8 +36,9 @@
  * @param[in]   pServer
  * @param[in]   hClient The handle to lookup
  * @param[out]  ppClient The RsClient associated with the handle
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverFindClient(RsServer *pServer, NvHandle hClient, RsClient **ppClient);
+static NV_STATUS _serverFindClient(RsServer *pServer, NvHandle hClient, RsClient **ppClient, RS_LOCK_INFO *pLockInfo);
 
 /**
  * Get the CLIENT_ENTRY from a client handle without taking locks
@@ -44,31 +46,66 @@ static NV_STATUS _serverFindClient(RsServer *pServer, NvHandle hClient, RsClient
  * @param[in]   hClient The handle to lookup
  * @param[in]   bFindPartial Include entries that have not finished constructing
  * @param[out]  ppClientEntry The client entry associated with the handle
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverFindClientEntry(RsServer *pServer, NvHandle hClient, NvBool bFindPartial, CLIENT_ENTRY **ppClientEntry);
+static NV_STATUS _serverFindClientEntry(RsServer *pServer, NvHandle hClient, NvBool bFindPartial, CLIENT_ENTRY **ppClientEntry, RS_LOCK_INFO *pLockInfo);
 
 /**
  * Insert a CLIENT_ENTRY in the server database without taking locks
  * @param[in]   pServer
  * @param[in]   pClientEntry The client entry associated with the handle
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverInsertClientEntry(RsServer *pServer, CLIENT_ENTRY *pClientEntry, CLIENT_ENTRY **ppClientNext);
+static NV_STATUS _serverInsertClientEntry(RsServer *pServer, CLIENT_ENTRY *pClientEntry, CLIENT_ENTRY **ppClientNext, RS_LOCK_INFO *pLockInfo);
+
+/**
+ * Remove a CLIENT_ENTRY from the server database without taking locks
+ * @param[in]   pServer
+ * @param[in]   hClient The handle the entry was inserted with
+ * @param[in]   pClientEntry The client entry to remove
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
+ */
+static void _serverRemoveClientEntry(RsServer *pServer, NvHandle hClient, CLIENT_ENTRY *pClientEntry, RS_LOCK_INFO *pLockInfo);
+
+/**
+ * Look up the pClientSortedList node holding a client handle in the RS_CLIENT_INDEX_HASH table.
+ * Must be called between _serverClientIndexReadBegin/End.
+ * @param[in]   pServer
+ * @param[in]   hClient The handle to lookup
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
+ */
+static CLIENT_ENTRY **_serverClientHashFind(RsServer *pServer, NvHandle hClient);
+
+/**
+ * Allocate an empty RS_CLIENT_INDEX_HASH table
+ * @param[in]   pAllocator
+ * @param[in]   size Number of slots, must be a power of 2
+ */
+static RS_CLIENT_HASH_TABLE *_serverClientHashTableCreate(PORT_MEM_ALLOCATOR *pAllocator, NvU32 size);
+
+/**
+ * Free the RS_CLIENT_INDEX_HASH table and lookup counters
+ * @param[in]   pServer
+ */
+static void _serverClientHashTableDestroy(RsServer *pServer);
 
 /**
  * Find the next available client handle in bucket.
  * @param[in]   pServer
  * @param[in]   hClientIn
  * @param[out]  pClientOut
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverFindNextAvailableClientHandleInBucket(RsServer *pServer, NvHandle hClientIn, NvHandle *phClientOut, CLIENT_ENTRY  ***pppClientNext);
+static NV_STATUS _serverFindNextAvailableClientHandleInBucket(RsServer *pServer, NvHandle hClientIn, NvHandle *phClientOut, CLIENT_ENTRY  ***pppClientNext, RS_LOCK_INFO *pLockInfo);
 
 /**
  * Create a client entry and a client lock for a client that does not exist yet. Used during client
  * construction. No locks will be taken if this call fails.
  * @param[in]   pServer
  * @param[in]   hClient
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverCreateEntryAndLockForNewClient(RsServer *pServer, NvHandle *phClient, NvBool bInternalHandle, CLIENT_ENTRY **ppClientEntry );
+static NV_STATUS _serverCreateEntryAndLockForNewClient(RsServer *pServer, NvHandle *phClient, NvBool bInternalHandle, CLIENT_ENTRY **ppClientEntry, RS_LOCK_INFO *pLockInfo);
 
 /**
  * Lock and retrieve the RsClient associated with a client handle.
@@ -76,8 +113,9 @@ static NV_STATUS _serverCreateEntryAndLockForNewClient(RsServer *pServer, NvHand
  * @param[in]   access
  * @param[in]   hClient Handle of client to look-up
  * @param[out]  pClient RsClient associated with the client handle
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverLockClient(RsServer *pServer, LOCK_ACCESS_TYPE access, NvHandle hClient, RsClient **ppClient);
+static NV_STATUS _serverLockClient(RsServer *pServer, LOCK_ACCESS_TYPE access, NvHandle hClient, RsClient **ppClient, RS_LOCK_INFO *pLockInfo);
 
 /**
  * Lock and retrieve the RsClient associated with a client handle, and update lock info.
@@ -104,8 +142,9 @@ static NV_STATUS _serverLockDualClientWithLockInfo(RsServer *pServer, LOCK_ACCES
  * @param[in]   pServer
  * @param[in]   access
  * @param[in]   hClient Handle of the client to unlock
+ * @param[inout] pLockInfo Per-call lock state for counting pClientListLock acquisitions, may be NULL
  */
-static NV_STATUS _serverUnlockClient(RsServer *pServer, LOCK_ACCESS_TYPE access, NvHandle hClient);
+static NV_STATUS _serverUnlockClient(RsServer *pServer, LOCK_ACCESS_TYPE access, NvHandle hClient, RS_LOCK_INFO *pLockInfo);
 
 /**
  * Unlock a client by handle, and update lock info.
@@ -213,7 +252,8 @@ serverConstruct
 (
     RsServer *pServer,
     RS_PRIV_LEVEL privilegeLevel,
-    NvU32     maxDomains
+    NvU32     maxDomains,
+    RS_CLIENT_INDEX_TYPE clientIndexType
 )
 {
     NvU32 i;
@@ -222,14 +262,29 @@ serverConstruct
     pServer->privilegeLevel     = privilegeLevel;
     pServer->bConstructed       = NV_TRUE;
     pServer->pAllocator         = pAllocator;
+    pServer->pRefAllocator      = pAllocator;
     pServer->bDebugFreeList     = NV_FALSE;
     pServer->bRsAccessEnabled   = NV_TRUE;
     pServer->internalHandleBase = RS_CLIENT_INTERNAL_HANDLE_BASE;
     pServer->activeClientCount  = 0;
     pServer->activeResourceCount= 0;
     pServer->roTopLockApiMask   = 0;
+    pServer->clientIndexType    = clientIndexType;
+    pServer->pClientHashTable   = NULL;
+    pServer->clientHashCount    = 0;
+    pServer->clientIndexSeq     = 0;
+    pServer->clientIndexEpoch   = 0;
+    pServer->pClientIndexReaders = NULL;
+    pServer->pClientIndexReadersAlloc = NULL;
     /* pServer->bUnlockedParamCopy is set in _rmapiLockAlloc */
 
+#if portMemExAllocatorCreateObjectCache_SUPPORTED
+    // Reference maps and lists allocate and free small nodes on every alloc/free
+    pServer->pRefAllocator = portMemExAllocatorCreateObjectCache();
+    if (pServer->pRefAllocator == NULL)
+        pServer->pRefAllocator = pAllocator;
+#endif
+
     pServer->pClientSortedList = PORT_ALLOC(pAllocator, sizeof(RsClientList)*RS_CLIENT_HANDLE_BUCKET_COUNT);
     if (NULL == pServer->pClientSortedList)
         goto fail;
@@ -240,6 +295,26 @@ serverConstruct
     }
     pServer->clientCurrentHandleIndex = 0;
 
+    if (clientIndexType == RS_CLIENT_INDEX_HASH)
+    {
+        NvLength readersSize = sizeof(RS_CLIENT_INDEX_READERS) * RS_CLIENT_INDEX_READER_STRIPES;
+
+        pServer->pClientHashTable = _serverClientHashTableCreate(pAllocator, RS_CLIENT_HASH_INITIAL_SIZE);
+        if (pServer->pClientHashTable == NULL)
+            goto fail;
+
+        // Over-allocate so the stripes can start on a cache line boundary
+        pServer->pClientIndexReadersAlloc = PORT_ALLOC(pAllocator,
+            readersSize + RS_CLIENT_INDEX_CACHE_LINE_SIZE - 1);
+        if (pServer->pClientIndexReadersAlloc == NULL)
+            goto fail;
+
+        pServer->pClientIndexReaders = (RS_CLIENT_INDEX_READERS *)(NvUPtr)
+            NV_ALIGN_UP((NvUPtr)pServer->pClientIndexReadersAlloc,
+                        RS_CLIENT_INDEX_CACHE_LINE_SIZE);
+        portMemSet(pServer->pClientIndexReaders, 0, readersSize);
+    }
+
     pServer->pClientListLock = portSyncRwLockCreate(pAllocator);
     if (pServer->pClientListLock == NULL)
         goto fail;
@@ -299,6 +374,11 @@ fail:
         PORT_FREE(pAllocator, pServer->pClientSortedList);
     }
 
+    _serverClientHashTableDestroy(pServer);
+
+    if (pServer->pRefAllocator != pAllocator)
+        portMemAllocatorRelease(pServer->pRefAllocator);
+
     if (pAllocator != NULL)
         portMemAllocatorRelease(pAllocator);
 
@@ -337,6 +417,7 @@ serverDestruct
     }
 
     PORT_FREE(pServer->pAllocator, pServer->pClientSortedList);
+    _serverClientHashTableDestroy(pServer);
     mapDestroy(&pServer->shareMap);
     listDestroy(&pServer->defaultInheritedSharePolicyList);
     listDestroy(&pServer->globalInternalSharePolicyList);
@@ -349,6 +430,8 @@ serverDestruct
     portSyncSpinlockDestroy(pServer->pShareMapLock);
     portSyncRwLockDestroy(pServer->pClientListLock);
 
+    if (pServer->pRefAllocator != pServer->pAllocator)
+        portMemAllocatorRelease(pServer->pRefAllocator);
     portMemAllocatorRelease(pServer->pAllocator);
 
     pServer->bConstructed = NV_FALSE;
@@ -361,7 +444,8 @@ NV_STATUS
 _serverFreeClient_underlock
 (
     RsServer *pServer,
-    RsClient *pClient
+    RsClient *pClient,
+    RS_LOCK_INFO *pLockInfo
 )
 {
     CLIENT_ENTRY *pClientEntry = NULL;
@@ -369,7 +453,7 @@ _serverFreeClient_underlock
     NV_STATUS status;
     PORT_RWLOCK *pLock = NULL;
 
-    status =_serverFindClientEntry(pServer, pClient->hClient, NV_FALSE, &pClientEntry);
+    status =_serverFindClientEntry(pServer, pClient->hClient, NV_FALSE, &pClientEntry, pLockInfo);
     if (status != NV_OK)
     {
         return status;
@@ -385,7 +469,7 @@ _serverFreeClient_underlock
 
     objDelete(pClient);
 
-    listRemoveFirstByValue(&pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK], &pClientEntry);
+    _serverRemoveClientEntry(pServer, hClient, pClientEntry, pLockInfo);
     pLock = pClientEntry->pLock;
 
     RS_RWLOCK_RELEASE_WRITE_EXT(pLock, &pClientEntry->lockVal, NV_TRUE);
@@ -492,7 +576,7 @@ serverAllocClient
     }
 #endif
 
-    status = _serverCreateEntryAndLockForNewClient(pServer, &hClient, !!(pParams->allocState & ALLOC_STATE_INTERNAL_CLIENT_HANDLE), &pClientEntry);
+    status = _serverCreateEntryAndLockForNewClient(pServer, &hClient, !!(pParams->allocState & ALLOC_STATE_INTERNAL_CLIENT_HANDLE), &pClientEntry, pParams->pLockInfo);
 
     if (status != NV_OK)
     {
@@ -521,13 +605,13 @@ serverAllocClient
 
 done:
     if (bLockedClient)
-        _serverUnlockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient);
+        _serverUnlockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient, pParams->pLockInfo);
 
     if ((status != NV_OK) && (status != NV_ERR_INSERT_DUPLICATE_NAME) && (hClient != 0))
     {
-        if (_serverFindClientEntry(pServer, hClient, NV_TRUE, &pClientEntry) == NV_OK)
+        if (_serverFindClientEntry(pServer, hClient, NV_TRUE, &pClientEntry, pParams->pLockInfo) == NV_OK)
         {
-            listRemoveFirstByValue(&pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK], &pClientEntry);
+            _serverRemoveClientEntry(pServer, hClient, pClientEntry, pParams->pLockInfo);
             portSyncRwLockDestroy(pClientEntry->pLock);
             PORT_FREE(pServer->pAllocator, pClientEntry);
         }
@@ -554,7 +638,7 @@ _serverFreeClient
     NvU32       releaseFlags = 0;
     RsClient   *pClient;
 
-    lockStatus = _serverLockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient, &pClient);
+    lockStatus = _serverLockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient, &pClient, pParams->pResFreeParams->pLockInfo);
     if (lockStatus != NV_OK)
     {
         status = NV_ERR_INVALID_CLIENT;
@@ -566,7 +650,7 @@ _serverFreeClient
     if (status != NV_OK)
         goto done;
 
-    status = _serverFreeClient_underlock(pServer, pClient);
+    status = _serverFreeClient_underlock(pServer, pClient, pParams->pResFreeParams->pLockInfo);
     if (status != NV_OK)
         goto done;
 
@@ -577,7 +661,7 @@ done:
     serverResLock_Epilogue(pServer, LOCK_ACCESS_WRITE, pParams->pResFreeParams->pLockInfo, &releaseFlags);
 
     if (releaseFlags & RS_LOCK_RELEASE_CLIENT_LOCK)
-        _serverUnlockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient);
+        _serverUnlockClient(pServer, LOCK_ACCESS_WRITE, pParams->hClient, pParams->pResFreeParams->pLockInfo);
 
     return status;
 }
@@ -1875,7 +1959,7 @@ serverAcquireClient
     RsClient   *pClient;
 
     // NV_PRINTF(LEVEL_INFO, "Acquiring hClient %x\n", hClient);
-    status = _serverLockClient(pServer, lockAccess, hClient, &pClient);
+    status = _serverLockClient(pServer, lockAccess, hClient, &pClient, NULL);
     if (status != NV_OK)
         return status;
 
@@ -1897,7 +1981,7 @@ serverGetClientUnderLock
     RsClient   *pClient;
 
     // NV_PRINTF(LEVEL_INFO, "Acquiring hClient %x (without lock)\n", hClient);
-    status = _serverFindClient(pServer, hClient, &pClient);
+    status = _serverFindClient(pServer, hClient, &pClient, NULL);
     if (status != NV_OK)
     {
         return status;
@@ -1918,10 +2002,353 @@ serverReleaseClient
 )
 {
     NV_STATUS status;
-    status = _serverUnlockClient(pServer, lockAccess, pClient->hClient);
+    status = _serverUnlockClient(pServer, lockAccess, pClient->hClient, NULL);
     return status;
 }
 
+//
+// RS_CLIENT_INDEX_HASH keeps every pClientSortedList node in a linear probing
+// hash table keyed by hClient.  The bucket lists are then only used for
+// iteration, so entries are appended rather than kept sorted, and lookups,
+// handle allocation and removal no longer walk a bucket.
+//
+// Lookups do not take pClientListLock.  Writers serialize on it and bump
+// clientIndexSeq to an odd value around every change; readers retry until
+// they complete a probe without the sequence moving.  Write sections are
+// short (a few slot updates, or a rehash when the table grows), and unlike
+// pClientListLock the retry loop never sleeps, so lookups stay usable
+// wherever the unlocked sorted-list lookup was.
+//
+// A lookup registers itself in the lookup counters for the current
+// clientIndexEpoch for as long as it dereferences table slots, list nodes and
+// CLIENT_ENTRYs.  Before a writer frees a table replaced by a resize or a list
+// node and CLIENT_ENTRY unlinked from the table, it flips the epoch and waits
+// for the lookups registered under the previous one to finish.  Lookups never
+// block on anything a writer holds while waiting, so the wait is bounded by
+// the length of a probe.
+//
+// This only covers the lookup itself.  Once _serverFindClientEntry returns,
+// the CLIENT_ENTRY stays valid under the same rules as for
+// RS_CLIENT_INDEX_SORTED_LIST: the caller's top level or client lock.
+//
+ct_assert(sizeof(RS_CLIENT_INDEX_READERS) == RS_CLIENT_INDEX_CACHE_LINE_SIZE);
+
+static NvU32
+_serverClientHashSlot
+(
+    NvU32    hashSize,
+    NvHandle hClient
+)
+{
+    // Handles are mostly sequential in their low bits, mix them before masking
+    return (NvU32)(((NvU64)hClient * 0x9E3779B97F4A7C15ULL) >> 32) & (hashSize - 1);
+}
+
+static RS_CLIENT_HASH_TABLE *
+_serverClientHashTableCreate
+(
+    PORT_MEM_ALLOCATOR *pAllocator,
+    NvU32               size
+)
+{
+    NvLength              allocSize = sizeof(RS_CLIENT_HASH_TABLE) + sizeof(CLIENT_ENTRY **) * size;
+    RS_CLIENT_HASH_TABLE *pTable = PORT_ALLOC(pAllocator, allocSize);
+
+    if (pTable == NULL)
+        return NULL;
+
+    portMemSet(pTable, 0, allocSize);
+    pTable->size     = size;
+    pTable->pppSlots = (CLIENT_ENTRY ***)(pTable + 1);
+
+    return pTable;
+}
+
+static void
+_serverClientHashTableDestroy
+(
+    RsServer *pServer
+)
+{
+    if (pServer->pClientHashTable != NULL)
+    {
+        PORT_FREE(pServer->pAllocator, pServer->pClientHashTable);
+        pServer->pClientHashTable = NULL;
+    }
+
+    if (pServer->pClientIndexReadersAlloc != NULL)
+    {
+        PORT_FREE(pServer->pAllocator, pServer->pClientIndexReadersAlloc);
+        pServer->pClientIndexReadersAlloc = NULL;
+        pServer->pClientIndexReaders = NULL;
+    }
+}
+
+static NvU32
+_serverClientIndexReadBegin
+(
+    RsServer *pServer,
+    NvU32    *pStripe
+)
+{
+    NvU32 stripe = (NvU32)portThreadGetCurrentThreadId() & (RS_CLIENT_INDEX_READER_STRIPES - 1);
+    NvU32 epoch;
+
+    //
+    // Only stay registered under an epoch that was still current after we
+    // registered; a writer flipping it concurrently either sees our count or
+    // we see its flip and register again.
+    //
+    for (;;)
+    {
+        epoch = pServer->clientIndexEpoch;
+        portAtomicIncrementU32(&pServer->pClientIndexReaders[stripe].count[epoch & 1]);
+        portAtomicMemoryFenceFull();
+
+        if (pServer->clientIndexEpoch == epoch)
+            break;
+
+        portAtomicDecrementU32(&pServer->pClientIndexReaders[stripe].count[epoch & 1]);
+    }
+
+    *pStripe = stripe;
+    return epoch;
+}
+
+static void
+_serverClientIndexReadEnd
+(
+    RsServer *pServer,
+    NvU32     stripe,
+    NvU32     epoch
+)
+{
+    portAtomicMemoryFenceFull();
+    portAtomicDecrementU32(&pServer->pClientIndexReaders[stripe].count[epoch & 1]);
+}
+
+//
+// Wait until no lookup can still reach anything the caller unlinked from the
+// table.  Must not be called between _serverClientIndexWriteBegin/End, lookups
+// that are still registered may be waiting for the write to finish.
+//
+static void
+_serverClientIndexSynchronize
+(
+    RsServer *pServer
+)
+{
+    NvU32 epoch;
+    NvU32 i;
+
+    portAtomicMemoryFenceFull();
+    epoch = portAtomicIncrementU32(&pServer->clientIndexEpoch) - 1;
+    portAtomicMemoryFenceFull();
+
+    for (i = 0; i < RS_CLIENT_INDEX_READER_STRIPES; i++)
+    {
+        while (pServer->pClientIndexReaders[i].count[epoch & 1] != 0)
+            portThreadYield();
+    }
+
+    portAtomicMemoryFenceFull();
+}
+
+static void
+_serverClientIndexWriteBegin
+(
+    RsServer     *pServer,
+    RS_LOCK_INFO *pLockInfo
+)
+{
+    portSyncRwLockAcquireWrite(pServer->pClientListLock);
+    if (pLockInfo != NULL)
+        pLockInfo->clientListLockAcquireCount++;
+
+    pServer->clientIndexSeq++;
+    portAtomicMemoryFenceStore();
+}
+
+static void
+_serverClientIndexWriteEnd
+(
+    RsServer *pServer
+)
+{
+    portAtomicMemoryFenceStore();
+    pServer->clientIndexSeq++;
+
+    portSyncRwLockReleaseWrite(pServer->pClientListLock);
+}
+
+static CLIENT_ENTRY **
+_serverClientHashProbe
+(
+    RS_CLIENT_HASH_TABLE *pTable,
+    NvHandle              hClient
+)
+{
+    NvU32 mask = pTable->size - 1;
+    NvU32 slot = _serverClientHashSlot(pTable->size, hClient);
+    NvU32 i;
+
+    // Bounded so a torn read during a concurrent change cannot spin forever
+    for (i = 0; i < pTable->size; i++)
+    {
+        CLIENT_ENTRY **ppClientEntry = pTable->pppSlots[slot];
+
+        if (ppClientEntry == NULL)
+            break;
+
+        if ((*ppClientEntry)->hClient == hClient)
+            return ppClientEntry;
+
+        slot = (slot + 1) & mask;
+    }
+
+    return NULL;
+}
+
+static CLIENT_ENTRY **
+_serverClientHashFind
+(
+    RsServer *pServer,
+    NvHandle  hClient
+)
+{
+    CLIENT_ENTRY **ppClientEntry;
+
+    for (;;)
+    {
+        NvU32 seq = pServer->clientIndexSeq;
+
+        if (seq & 1)
+        {
+            // A writer is mid-update; write sections are short, try again
+            portAtomicMemoryFenceLoad();
+            continue;
+        }
+
+        portAtomicMemoryFenceLoad();
+        ppClientEntry = _serverClientHashProbe(pServer->pClientHashTable, hClient);
+        portAtomicMemoryFenceLoad();
+
+        if (pServer->clientIndexSeq == seq)
+            return ppClientEntry;
+    }
+}
+
+static void
+_serverClientHashPlace
+(
+    RS_CLIENT_HASH_TABLE *pTable,
+    CLIENT_ENTRY        **ppClientEntry
+)
+{
+    NvU32 slot = _serverClientHashSlot(pTable->size, (*ppClientEntry)->hClient);
+
+    while (pTable->pppSlots[slot] != NULL)
+        slot = (slot + 1) & (pTable->size - 1);
+
+    pTable->pppSlots[slot] = ppClientEntry;
+}
+
+//
+// Called between _serverClientIndexWriteBegin/End.  A table replaced by a
+// resize is returned in *ppOldTable, to be freed after
+// _serverClientIndexSynchronize.
+//
+static NV_STATUS
+_serverClientHashInsert
+(
+    RsServer              *pServer,
+    CLIENT_ENTRY         **ppClientEntry,
+    RS_CLIENT_HASH_TABLE **ppOldTable
+)
+{
+    RS_CLIENT_HASH_TABLE *pTable = pServer->pClientHashTable;
+
+    // Keep the load factor at or below 1/2 so probe sequences stay short
+    if ((pServer->clientHashCount + 1) * 2 > pTable->size)
+    {
+        RS_CLIENT_HASH_TABLE *pNewTable;
+        NvU32                 i;
+
+        if (pTable->size * 2 < pTable->size)
+            return NV_ERR_INSUFFICIENT_RESOURCES;
+
+        pNewTable = _serverClientHashTableCreate(pServer->pAllocator, pTable->size * 2);
+        if (pNewTable == NULL)
+            return NV_ERR_INSUFFICIENT_RESOURCES;
+
+        for (i = 0; i < pTable->size; i++)
+        {
+            if (pTable->pppSlots[i] != NULL)
+                _serverClientHashPlace(pNewTable, pTable->pppSlots[i]);
+        }
+
+        // Publish the fully built table, lookups may still be probing the old one
+        portAtomicMemoryFenceStore();
+        pServer->pClientHashTable = pNewTable;
+
+        *ppOldTable = pTable;
+        pTable = pNewTable;
+    }
+
+    _serverClientHashPlace(pTable, ppClientEntry);
+    pServer->clientHashCount++;
+
+    return NV_OK;
+}
+
+// Called between _serverClientIndexWriteBegin/End
+static CLIENT_ENTRY **
+_serverClientHashRemove
+(
+    RsServer      *pServer,
+    NvHandle       hClient,
+    CLIENT_ENTRY  *pClientEntry
+)
+{
+    RS_CLIENT_HASH_TABLE *pTable = pServer->pClientHashTable;
+    NvU32 mask = pTable->size - 1;
+    NvU32 slot = _serverClientHashSlot(pTable->size, hClient);
+    NvU32 next;
+    CLIENT_ENTRY **ppClientEntry;
+
+    // Match on the entry itself, its hClient may already have been cleared
+    while ((ppClientEntry = pTable->pppSlots[slot]) == NULL ||
+           *ppClientEntry != pClientEntry)
+    {
+        if (ppClientEntry == NULL)
+            return NULL;
+
+        slot = (slot + 1) & mask;
+    }
+
+    //
+    // Backward shift deletion: pull later entries of the probe run into the
+    // hole unless their home slot lies cyclically after the hole.
+    //
+    for (next = (slot + 1) & mask;
+         pTable->pppSlots[next] != NULL;
+         next = (next + 1) & mask)
+    {
+        NvU32 home = _serverClientHashSlot(pTable->size, (*pTable->pppSlots[next])->hClient);
+
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            pTable->pppSlots[slot] = pTable->pppSlots[next];
+            slot = next;
+        }
+    }
+
+    pTable->pppSlots[slot] = NULL;
+    pServer->clientHashCount--;
+
+    return ppClientEntry;
+}
+
 static
 NV_STATUS
 _serverFindClientEntry
@@ -1929,7 +2356,8 @@ _serverFindClientEntry
     RsServer      *pServer,
     NvHandle       hClient,
     NvBool         bFindPartial,
-    CLIENT_ENTRY **ppClientEntry
+    CLIENT_ENTRY **ppClientEntry,
+    RS_LOCK_INFO  *pLockInfo
 )
 {
     RsClientList  *pClientList       = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
@@ -1938,6 +2366,34 @@ _serverFindClientEntry
     if (ppClientEntry != NULL)
         *ppClientEntry = NULL;
 
+    if (pServer->clientIndexType == RS_CLIENT_INDEX_HASH)
+    {
+        CLIENT_ENTRY **ppClientEntryFound;
+        CLIENT_ENTRY  *pClientEntry = NULL;
+        NV_STATUS      status = NV_ERR_INVALID_OBJECT_HANDLE;
+        NvU32          stripe;
+        NvU32          epoch;
+
+        epoch = _serverClientIndexReadBegin(pServer, &stripe);
+
+        ppClientEntryFound = _serverClientHashFind(pServer, hClient);
+        if (ppClientEntryFound != NULL)
+        {
+            pClientEntry = *ppClientEntryFound;
+
+            // Client may not have finished constructing yet
+            if (pClientEntry->pClient != NULL || bFindPartial)
+                status = NV_OK;
+        }
+
+        _serverClientIndexReadEnd(pServer, stripe, epoch);
+
+        if ((status == NV_OK) && (ppClientEntry != NULL))
+            *ppClientEntry = pClientEntry;
+
+        return status;
+    }
+
     while (ppClientEntryLoop != NULL)
     {
         CLIENT_ENTRY *pClientEntry = *ppClientEntryLoop;
@@ -1973,12 +2429,13 @@ _serverFindClient
 (
     RsServer      *pServer,
     NvHandle       hClient,
-    RsClient     **ppClient
+    RsClient     **ppClient,
+    RS_LOCK_INFO  *pLockInfo
 )
 {
     CLIENT_ENTRY *pClientEntry;
     NV_STATUS status;
-    status =_serverFindClientEntry(pServer, hClient, NV_FALSE, &pClientEntry);
+    status =_serverFindClientEntry(pServer, hClient, NV_FALSE, &pClientEntry, pLockInfo);
     if (status != NV_OK)
     {
         return status;
@@ -1994,7 +2451,8 @@ _serverInsertClientEntry
 (
     RsServer      *pServer,
     CLIENT_ENTRY  *pClientEntry,
-    CLIENT_ENTRY **ppClientNext
+    CLIENT_ENTRY **ppClientNext,
+    RS_LOCK_INFO  *pLockInfo
 )
 {
     RsClientList  *pClientList;
@@ -2016,11 +2474,72 @@ _serverInsertClientEntry
     {
         ppClientEntry = (CLIENT_ENTRY **)listInsertNew(pClientList, ppClientNext);
     }
+
+    if (ppClientEntry == NULL)
+    {
+        return NV_ERR_INSUFFICIENT_RESOURCES;
+    }
     *ppClientEntry = pClientEntry;
 
+    if (pServer->clientIndexType == RS_CLIENT_INDEX_HASH)
+    {
+        RS_CLIENT_HASH_TABLE *pOldTable = NULL;
+        NV_STATUS             status;
+
+        _serverClientIndexWriteBegin(pServer, pLockInfo);
+        status = _serverClientHashInsert(pServer, ppClientEntry, &pOldTable);
+        _serverClientIndexWriteEnd(pServer);
+
+        if (pOldTable != NULL)
+        {
+            _serverClientIndexSynchronize(pServer);
+            PORT_FREE(pServer->pAllocator, pOldTable);
+        }
+
+        if (status != NV_OK)
+        {
+            listRemove(pClientList, ppClientEntry);
+            return status;
+        }
+    }
+
     return NV_OK;
 }
 
+static
+void
+_serverRemoveClientEntry
+(
+    RsServer      *pServer,
+    NvHandle       hClient,
+    CLIENT_ENTRY  *pClientEntry,
+    RS_LOCK_INFO  *pLockInfo
+)
+{
+    RsClientList  *pClientList = &(pServer->pClientSortedList[hClient & RS_CLIENT_HANDLE_BUCKET_MASK]);
+
+    if (pServer->clientIndexType == RS_CLIENT_INDEX_HASH)
+    {
+        CLIENT_ENTRY **ppClientEntry;
+
+        _serverClientIndexWriteBegin(pServer, pLockInfo);
+        ppClientEntry = _serverClientHashRemove(pServer, hClient, pClientEntry);
+        _serverClientIndexWriteEnd(pServer);
+
+        //
+        // Lookups may still be holding the list node or the entry, wait for
+        // them before the node is freed here and the entry by our caller.
+        //
+        _serverClientIndexSynchronize(pServer);
+
+        NV_ASSERT_OR_RETURN_VOID(ppClientEntry != NULL);
+        listRemove(pClientList, ppClientEntry);
+        return;
+    }
+
+    listRemoveFirstByValue(pClientList, &pClientEntry);
+}
+
 static
 NV_STATUS
 _serverFindNextAvailableClientHandleInBucket
@@ -2028,7 +2547,8 @@ _serverFindNextAvailableClientHandleInBucket
     RsServer        *pServer,
     NvHandle         hClientIn,
     NvHandle         *phClientOut,
-    CLIENT_ENTRY  ***pppClientNext
+    CLIENT_ENTRY  ***pppClientNext,
+    RS_LOCK_INFO     *pLockInfo
 )
 {
     NvHandle        hPrefixIn, hPrefixOut;
@@ -2037,6 +2557,32 @@ _serverFindNextAvailableClientHandleInBucket
     CLIENT_ENTRY **ppClientEntry = listHead(pClientList);
 
     *pppClientNext = NULL;
+
+    if (pServer->clientIndexType == RS_CLIENT_INDEX_HASH)
+    {
+        NV_STATUS status = NV_OK;
+        NvU32     stripe;
+        NvU32     epoch;
+
+        epoch = _serverClientIndexReadBegin(pServer, &stripe);
+
+        // Unsorted buckets: probe successive handles in the same bucket directly
+        while (_serverClientHashFind(pServer, hClientOut) != NULL)
+        {
+            hClientOut = hClientOut + RS_CLIENT_HANDLE_BUCKET_COUNT;
+            if ((hClientOut & ~RS_CLIENT_HANDLE_DECODE_MASK) != (hClientIn & ~RS_CLIENT_HANDLE_DECODE_MASK))
+            {
+                status = NV_ERR_INSUFFICIENT_RESOURCES;
+                break;
+            }
+        }
+
+        _serverClientIndexReadEnd(pServer, stripe, epoch);
+
+        if (status == NV_OK)
+            *phClientOut = hClientOut;
+        return status;
+    }
     if (ppClientEntry == NULL)
     {
         *phClientOut = hClientOut;
@@ -2089,7 +2635,8 @@ _serverCreateEntryAndLockForNewClient
     RsServer      *pServer,
     NvHandle      *phClient,
     NvBool         bInternalHandle,
-    CLIENT_ENTRY **ppClientEntry
+    CLIENT_ENTRY **ppClientEntry,
+    RS_LOCK_INFO  *pLockInfo
 )
 {
     CLIENT_ENTRY  *pClientEntry;
@@ -2121,7 +2668,7 @@ _serverCreateEntryAndLockForNewClient
                 goto _serverCreateEntryAndLockForNewClient_exit;
             }
         }
-        while (_serverFindNextAvailableClientHandleInBucket(pServer, hClient, &hClient, &ppClientNext) != NV_OK);
+        while (_serverFindNextAvailableClientHandleInBucket(pServer, hClient, &hClient, &ppClientNext, pLockInfo) != NV_OK);
 
         pServer->clientCurrentHandleIndex = clientHandleIndex;
     }
@@ -2137,13 +2684,13 @@ _serverCreateEntryAndLockForNewClient
             : CLIENT_ENCODEHANDLE(clientIndex);
 #endif
 
-        if (_serverFindClientEntry(pServer, hClient, NV_FALSE, NULL) == NV_OK)
+        if (_serverFindClientEntry(pServer, hClient, NV_FALSE, NULL, pLockInfo) == NV_OK)
         {
             // The handle already exists
             status = NV_ERR_INSERT_DUPLICATE_NAME;
             goto _serverCreateEntryAndLockForNewClient_exit;
         }
-        status = _serverFindNextAvailableClientHandleInBucket(pServer, hClient, &hClientOut, &ppClientNext);
+        status = _serverFindNextAvailableClientHandleInBucket(pServer, hClient, &hClientOut, &ppClientNext, pLockInfo);
         if (status != NV_OK)
         {
              goto _serverCreateEntryAndLockForNewClient_exit;
@@ -2181,7 +2728,7 @@ _serverCreateEntryAndLockForNewClient
                            bInternalHandle ? LOCK_VAL_LOCK_CLASS_CLIENT_INTERNAL : LOCK_VAL_LOCK_CLASS_CLIENT,
                            hClient);
 
-    status = _serverInsertClientEntry(pServer, pClientEntry, ppClientNext);
+    status = _serverInsertClientEntry(pServer, pClientEntry, ppClientNext, pLockInfo);
     if (status != NV_OK)
     {
         PORT_FREE(pServer->pAllocator, pClientEntry);
@@ -2209,14 +2756,15 @@ _serverLockClient
     RsServer *pServer,
     LOCK_ACCESS_TYPE access,
     NvHandle hClient,
-    RsClient **ppClient
+    RsClient **ppClient,
+    RS_LOCK_INFO *pLockInfo
 )
 {
     RsClient *pClient;
     CLIENT_ENTRY *pClientEntry = NULL;
     NV_STATUS status = NV_OK;
 
-    status =_serverFindClientEntry(pServer, hClient, NV_FALSE, &pClientEntry);
+    status =_serverFindClientEntry(pServer, hClient, NV_FALSE, &pClientEntry, pLockInfo);
     if (status != NV_OK)
     {
         return status;
@@ -2273,14 +2821,14 @@ _serverLockClientWithLockInfo
     NV_STATUS status;
     if ((pLockInfo->flags & RS_LOCK_FLAGS_NO_CLIENT_LOCK))
     {
-        status = _serverFindClient(pServer, hClient, ppClient);
+        status = _serverFindClient(pServer, hClient, ppClient, pLockInfo);
         return status;
     }
 
     if ((pLockInfo->state & RS_LOCK_STATE_CLIENT_LOCK_ACQUIRED))
     {
         CLIENT_ENTRY *pClientEntry;
-        NV_ASSERT_OK_OR_RETURN(_serverFindClientEntry(pServer, hClient, NV_FALSE, &pClientEntry));
+        NV_ASSERT_OK_OR_RETURN(_serverFindClientEntry(pServer, hClient, NV_FALSE, &pClientEntry, pLockInfo));
         NV_ASSERT_OR_RETURN(pLockInfo->pClient != NULL, NV_ERR_INVALID_STATE);
         NV_ASSERT_OR_RETURN(pLockInfo->pClient == pClientEntry->pClient, NV_ERR_INVALID_STATE);
         NV_ASSERT_OR_RETURN(pClientEntry->lockOwnerTid == portThreadGetCurrentThreadId(), NV_ERR_INVALID_STATE);
@@ -2289,7 +2837,7 @@ _serverLockClientWithLockInfo
         return NV_OK;
     }
 
-    status = _serverLockClient(pServer, access, hClient, ppClient);
+    status = _serverLockClient(pServer, access, hClient, ppClient, pLockInfo);
     if (status != NV_OK)
         return status;
 
@@ -2327,7 +2875,7 @@ _serverLockDualClientWithLockInfo
 
     if ((pLockInfo->flags & RS_LOCK_FLAGS_NO_CLIENT_LOCK))
     {
-        status = _serverFindClient(pServer, hClient1, ppClient1);
+        status = _serverFindClient(pServer, hClient1, ppClient1, pLockInfo);
         if (status != NV_OK)
             return status;
 
@@ -2337,7 +2885,7 @@ _serverLockDualClientWithLockInfo
         }
         else
         {
-            status = _serverFindClient(pServer, hClient2, ppClient2);
+            status = _serverFindClient(pServer, hClient2, ppClient2, pLockInfo);
         }
 
         return status;
@@ -2368,11 +2916,11 @@ _serverLockDualClientWithLockInfo
         NV_ASSERT_OR_RETURN(pLockInfo->pClient->hClient == hClient1st, NV_ERR_INVALID_STATE);
         NV_ASSERT_OR_RETURN(pLockInfo->pSecondClient->hClient == hClient2nd, NV_ERR_INVALID_STATE);
 
-        NV_ASSERT_OK_OR_RETURN(_serverFindClientEntry(pServer, hClient1st, NV_FALSE, &pClientEntry));
+        NV_ASSERT_OK_OR_RETURN(_serverFindClientEntry(pServer, hClient1st, NV_FALSE, &pClientEntry, pLockInfo));
         NV_ASSERT_OR_RETURN(pClientEntry->pClient == pLockInfo->pClient, NV_ERR_INVALID_STATE);
         NV_ASSERT_OR_RETURN(pClientEntry->lockOwnerTid == portThreadGetCurrentThreadId(), NV_ERR_INVALID_STATE);
 
-        NV_ASSERT_OK_OR_RETURN(_serverFindClientEntry(pServer, hClient2nd, NV_FALSE, &pSecondClientEntry));
+        NV_ASSERT_OK_OR_RETURN(_serverFindClientEntry(pServer, hClient2nd, NV_FALSE, &pSecondClientEntry, pLockInfo));
         NV_ASSERT_OR_RETURN(pSecondClientEntry->pClient == pLockInfo->pSecondClient, NV_ERR_INVALID_STATE);
         NV_ASSERT_OR_RETURN(pSecondClientEntry->lockOwnerTid == pClientEntry->lockOwnerTid, NV_ERR_INVALID_STATE);
 
@@ -2381,7 +2929,7 @@ _serverLockDualClientWithLockInfo
         return NV_OK;
     }
 
-    status = _serverLockClient(pServer, access, hClient1st, ppClient1st);
+    status = _serverLockClient(pServer, access, hClient1st, ppClient1st, pLockInfo);
     if (status != NV_OK)
         return status;
 
@@ -2391,10 +2939,10 @@ _serverLockDualClientWithLockInfo
     }
     else
     {
-        status = _serverLockClient(pServer, access, hClient2nd, ppClient2nd);
+        status = _serverLockClient(pServer, access, hClient2nd, ppClient2nd, pLockInfo);
         if (status != NV_OK)
         {
-            _serverUnlockClient(pServer, access, hClient1st);
+            _serverUnlockClient(pServer, access, hClient1st, pLockInfo);
             return status;
         }
     }
@@ -2413,13 +2961,14 @@ _serverUnlockClient
 (
     RsServer *pServer,
     LOCK_ACCESS_TYPE access,
-    NvHandle hClient
+    NvHandle hClient,
+    RS_LOCK_INFO *pLockInfo
 )
 {
     CLIENT_ENTRY *pClientEntry = NULL;
     NV_STATUS status = NV_OK;
 
-    status =_serverFindClientEntry(pServer, hClient, NV_TRUE, &pClientEntry);
+    status =_serverFindClientEntry(pServer, hClient, NV_TRUE, &pClientEntry, pLockInfo);
     if (status != NV_OK)
     {
         return status;
@@ -2452,7 +3001,7 @@ _serverUnlockClientWithLockInfo
     NV_STATUS status;
     if (*pReleaseFlags & RS_LOCK_RELEASE_CLIENT_LOCK)
     {
-        status = _serverUnlockClient(pServer, access, hClient);
+        status = _serverUnlockClient(pServer, access, hClient, pLockInfo);
         if (status != NV_OK)
             return status;
 
@@ -2482,9 +3031,9 @@ _serverUnlockDualClientWithLockInfo
     if (*pReleaseFlags & RS_LOCK_RELEASE_CLIENT_LOCK)
     {
         // Try to unlock both, even if one fails
-        NV_ASSERT_OK(_serverUnlockClient(pServer, access, hClient2nd));
+        NV_ASSERT_OK(_serverUnlockClient(pServer, access, hClient2nd, pLockInfo));
         if (hClient1 != hClient2)
-            NV_ASSERT_OK(_serverUnlockClient(pServer, access, hClient1st));
+            NV_ASSERT_OK(_serverUnlockClient(pServer, access, hClient1st, pLockInfo));
 
         pLockInfo->state &= ~RS_LOCK_STATE_CLIENT_LOCK_ACQUIRED;
         pLockInfo->pClient = NULL;
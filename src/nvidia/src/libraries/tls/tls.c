@@ -57,9 +57,28 @@ typedef struct ThreadEntry
 MAKE_INTRUSIVE_MAP(ThreadEntryMap, ThreadEntry, node);
 
 /**
- * @brief Stores all necessary data for TLS mechanism.
+ * @brief Number of lock stripes for passive thread entries. Must be a power of 2.
  *
- * @todo Use RW Spinlocks instead. Nice perf boost.
+ * Every RM entry point looks up its thread entry, so a single lock over all
+ * passive threads serializes unrelated CPUs. Each bucket is protected by its
+ * own spinlock; threads only contend when their ids hash to the same bucket.
+ */
+#define TLS_THREAD_ENTRY_BUCKETS_LOG2 6
+#define TLS_THREAD_ENTRY_BUCKETS      (1 << TLS_THREAD_ENTRY_BUCKETS_LOG2)
+
+/**
+ * @brief One lock stripe of the passive thread entry table.
+ */
+typedef struct ThreadEntryBucket
+{
+    /// @brief Lock for this bucket's thread entry map
+    PORT_SPINLOCK *pLock;
+    /// @brief Map of thread entries of non ISR threads hashing to this bucket.
+    ThreadEntryMap threadEntries;
+} ThreadEntryBucket;
+
+/**
+ * @brief Stores all necessary data for TLS mechanism.
  */
 typedef struct TlsDatabase
 {
@@ -68,10 +87,8 @@ typedef struct TlsDatabase
     /// @brief Last allocated entry id.
     NvU64 lastEntryId;
 
-    /// @brief Lock for the passive thread entry map
-    PORT_SPINLOCK *pLock;
-    /// @brief Map of thread entries of non ISR threads.
-    ThreadEntryMap threadEntries;
+    /// @brief Lock-striped table of thread entries of non ISR threads.
+    ThreadEntryBucket threadBuckets[TLS_THREAD_ENTRY_BUCKETS];
 
 #if TLS_ISR_CAN_USE_LOCK
     /// @brief Lock which controls access to ISR-specific structures
@@ -108,6 +125,7 @@ TlsDatabase tlsDatabase; // Zero initialized
 
 // Helper function prototypes
 static NvBool              _tlsIsIsr(void);
+static ThreadEntryBucket  *_tlsThreadEntryBucketGet(NvU64 threadId);
 static ThreadEntry        *_tlsThreadEntryGet(void);
 static ThreadEntry        *_tlsThreadEntryGetOrAlloc(void);
 static NvP64               *_tlsEntryAcquire(ThreadEntry *pThreadEntry, NvU64 entryId, PORT_MEM_ALLOCATOR *pCustomAllocator);
@@ -166,13 +184,21 @@ NV_STATUS tlsInitialize()
         goto done;
     }
 
-    tlsDatabase.pLock = portSyncSpinlockCreate(tlsDatabase.pAllocator);
-    if (tlsDatabase.pLock == NULL)
+{
+    NvU32 i;
+    for (i = 0; i < TLS_THREAD_ENTRY_BUCKETS; i++)
     {
-        status = NV_ERR_INSUFFICIENT_RESOURCES;
-        goto done;
+        ThreadEntryBucket *pBucket = &tlsDatabase.threadBuckets[i];
+
+        mapInitIntrusive(&pBucket->threadEntries);
+        pBucket->pLock = portSyncSpinlockCreate(tlsDatabase.pAllocator);
+        if (pBucket->pLock == NULL)
+        {
+            status = NV_ERR_INSUFFICIENT_RESOURCES;
+            goto done;
+        }
     }
-    mapInitIntrusive(&tlsDatabase.threadEntries);
+}
 
     status = _tlsIsrEntriesInit();
     if (status != NV_OK)
@@ -215,9 +241,17 @@ void tlsShutdown()
     _tlsProfilePrint();
 #endif
 
-    mapDestroy(&tlsDatabase.threadEntries);
-    if (tlsDatabase.pLock)
-        portSyncSpinlockDestroy(tlsDatabase.pLock);
+{
+    NvU32 i;
+    for (i = 0; i < TLS_THREAD_ENTRY_BUCKETS; i++)
+    {
+        ThreadEntryBucket *pBucket = &tlsDatabase.threadBuckets[i];
+
+        mapDestroy(&pBucket->threadEntries);
+        if (pBucket->pLock)
+            portSyncSpinlockDestroy(pBucket->pLock);
+    }
+}
 
     _tlsIsrEntriesDestroy();
 
@@ -414,6 +448,14 @@ NvU32 tlsEntryUnreference(NvU64 entryId)
 }
 
 
+static ThreadEntryBucket *
+_tlsThreadEntryBucketGet(NvU64 threadId)
+{
+    // Fibonacci hashing; thread ids are often aligned pointers or sequential.
+    NvU64 hash = threadId * 0x9E3779B97F4A7C15ULL;
+    return &tlsDatabase.threadBuckets[hash >> (64 - TLS_THREAD_ENTRY_BUCKETS_LOG2)];
+}
+
 static ThreadEntry *
 _tlsThreadEntryGet()
 {
@@ -426,9 +468,10 @@ _tlsThreadEntryGet()
     else
     {
         NvU64 threadId = portThreadGetCurrentThreadId();
-        portSyncSpinlockAcquire(tlsDatabase.pLock);
-          pThreadEntry = mapFind(&tlsDatabase.threadEntries, threadId);
-        portSyncSpinlockRelease(tlsDatabase.pLock);
+        ThreadEntryBucket *pBucket = _tlsThreadEntryBucketGet(threadId);
+        portSyncSpinlockAcquire(pBucket->pLock);
+          pThreadEntry = mapFind(&pBucket->threadEntries, threadId);
+        portSyncSpinlockRelease(pBucket->pLock);
     }
     return pThreadEntry;
 }
@@ -446,13 +489,16 @@ _tlsThreadEntryGetOrAlloc()
         pThreadEntry = PORT_ALLOC(tlsDatabase.pAllocator, sizeof(*pThreadEntry));
         if (pThreadEntry != NULL)
         {
+            ThreadEntryBucket *pBucket;
+
             pThreadEntry->key.threadId = portThreadGetCurrentThreadId();
             mapInitIntrusive(&pThreadEntry->map);
-            portSyncSpinlockAcquire(tlsDatabase.pLock);
-              mapInsertExisting(&tlsDatabase.threadEntries,
+            pBucket = _tlsThreadEntryBucketGet(pThreadEntry->key.threadId);
+            portSyncSpinlockAcquire(pBucket->pLock);
+              mapInsertExisting(&pBucket->threadEntries,
                                 pThreadEntry->key.threadId,
                                 pThreadEntry);
-            portSyncSpinlockRelease(tlsDatabase.pLock);
+            portSyncSpinlockRelease(pBucket->pLock);
         }
     }
 
@@ -508,11 +554,13 @@ _tlsEntryRelease
         // Only non ISR Thread Entry can be deallocated.
         if (!_tlsIsIsr() && (mapCount(&pThreadEntry->map) == 0))
         {
+            ThreadEntryBucket *pBucket = _tlsThreadEntryBucketGet(pThreadEntry->key.threadId);
+
             NV_ASSERT(portMemExSafeForNonPagedAlloc());
             mapDestroy(&pThreadEntry->map);
-            portSyncSpinlockAcquire(tlsDatabase.pLock);
-              mapRemove(&tlsDatabase.threadEntries, pThreadEntry);
-            portSyncSpinlockRelease(tlsDatabase.pLock);
+            portSyncSpinlockAcquire(pBucket->pLock);
+              mapRemove(&pBucket->threadEntries, pThreadEntry);
+            portSyncSpinlockRelease(pBucket->pLock);
             PORT_FREE(tlsDatabase.pAllocator, pThreadEntry);
         }
     }
@@ -540,7 +588,7 @@ static PORT_MEM_ALLOCATOR *_tlsAllocatorGet(void)
 static NV_STATUS _tlsIsrEntriesInit()
 {
     tlsDatabase.pIsrLock = portSyncSpinlockCreate(tlsDatabase.pAllocator);
-    if (tlsDatabase.pLock == NULL)
+    if (tlsDatabase.pIsrLock == NULL)
     {
         return NV_ERR_INSUFFICIENT_RESOURCES;
     }